@@ -29,11 +29,96 @@
 * 	08/04/2019:
 * 	Ported module for use with LICC v3.0.
 *
+* 	08/05/2019:
+* 	Fixed the per-pin output read shifts, the missing GPIOB clock enable and
+* 	the TIM17 update flag never being cleared. Pin set/clear and output read
+* 	now use the table driven socket map (Socket.c). Added test result record
+* 	and optional output oscillation post-pass.
+*
+* 	08/06/2019:
+* 	Added per-pin settle time offsets from fixture calibration.
+*
+* 	08/07/2019:
+* 	Gate loops now compile the IC into a vector program once per IC type,
+* 	applied and read port-wide. Added response signature mode using the
+* 	hardware CRC unit.
+*
+* 	08/08/2019:
+* 	Added fault diagnosis of rejected ICs through the fault dictionary.
+*
+* 	08/09/2019:
+* 	Vectors ordered by fault detection likelihood, optionally learned from
+* 	the faults logged on rejected ICs.
+*
+* 	08/10/2019:
+* 	Added screen, standard, full and characterize test tiers.
+*
+* 	08/11/2019:
+* 	Added 74HC164, shift register class ICs tested through ShiftReg.c.
+*
+* 	08/12/2019:
+* 	Added 74HC393, counter class ICs tested through Counter.c.
+*
+* 	08/17/2019:
+* 	Added user ICs, gates given by a truth table instead of a failure
+* 	function and compiled into the same vector program.
+*
+* 	08/19/2019:
+* 	Mismatching output reads resampled and put to a majority vote.
+*
+* 	08/20/2019:
+* 	Per-IC drive profiles (output speed, output pulls, settle time) applied
+* 	when testing, with measurement of settle time at each output speed.
+*
+* 	08/22/2019:
+* 	Optional logic family classification of passing gate ICs.
+*
+* 	08/23/2019:
+* 	Optional IDDQ screening, sampled in the functional test settle window.
+*
+* 	08/24/2019:
+* 	Tests abandoned on an over-current shutdown.
+*
+* 	08/25/2019:
+* 	Bridging vectors drive every gate at once so each pair of adjacent DIP
+* 	pins is seen at opposite levels, in both polarities.
+*
+* 	08/26/2019:
+* 	Open-drain outputs read with the MCU pull-ups on.
+*
+* 	08/27/2019:
+* 	Failing vectors of a reject kept for a fast retest.
+*
+* 	08/28/2019:
+* 	Results tagged with die temperature and VDDA.
+*
+* 	08/29/2019:
+* 	Hot path stages timed per IC type in Debug builds (see Profile.c).
+*
+* 	08/30/2019:
+* 	Retested vectors applied with every input at its level in the original
+* 	run. Settle time of an IC made public for the shift register test.
+*
 * 	Created on: 12/09/2018
 * 	Author: Anthony Needles
 ******************************************************************************/
 #include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Oscillation.h"
 #include "Checker.h"
+#include "FaultDict.h"
+#include "FailLog.h"
+#include "ShiftReg.h"
+#include "Counter.h"
+#include "Parametric.h"
+#include "Family.h"
+#include "Adc.h"
+#include "Iddq.h"
+#include "OverCurrent.h"
+#include "Workspace.h"
+#include "Conditions.h"
+#include "Profile.h"
 
 /******************************************************************************
 * Private Definitions
@@ -57,11 +142,162 @@
 #define FAILED 0U
 #define SET 1U
 
+#define CHECKER_PRIOR_WEIGHT 1U
+// Weight of every stuck-at fault before any have been logged
+
+#define CHECKER_REORDER_INTERVAL 16U
+// Number of logged faults after which the vector order is recomputed
+
+#define CHECKER_VECTOR_OVERHEAD 48U
+// Estimated SYSCLK cycles to apply, read and compare one vector on top of
+// the settle time, used for tier duration estimates
+
+#define CHECKER_TIMING_LIMIT (4U * CYCLES_DELAY)
+// Longest propagation delay measured before an output is given up on
+
+#define CHECKER_MARGIN_RESOLUTION 8U
+// Settle margin search stops once the passing and failing settle times are
+// within this many SYSCLK cycles
+
+#define CHECKER_NUM_ADJACENT 10U
+// Pairs of neighbouring signal pins along each side of the DIP package
+
+#define CHECKER_MAX_SETTLE 0xFFFFU
+// Longest settle time TIM17 can time
+
+#define CHECKER_VOTE_SPACING 24U
+// SYSCLK cycles between vote samples (0.5us), so a single glitch is not
+// sampled twice
+
+typedef struct {
+	uint8_t valid;
+	IC_PARAMETERS_T IC;
+	uint64_t vector_ids;
+	uint16_t fault;
+	uint8_t fail_vector;
+	uint8_t attempts;
+} CHECKER_FAILURE_T;
+// Rejected IC awaiting retest: its parameters (for recompiling), failing
+// vectors by gate loop order index (stable across reordering), diagnosed
+// fault, first failing vector and retests made so far
+
+typedef enum {CHECKER_PASS_FUNCTIONAL,
+			  CHECKER_PASS_SIGNATURE,
+			  CHECKER_PASS_DIAGNOSTIC,
+			  CHECKER_PASS_TIMING,
+			  CHECKER_PASS_OSCILLATION,
+			  CHECKER_PASS_RETEST
+} CHECKER_PASS_T;
+// Type of pass made over the vector program
+
+/******************************************************************************
+* Public Constants
+******************************************************************************/
+const IC_PARAMETERS_T IC_74HC00_PARAM = {IC_74HC00, 8, 4,
+										{1, 2, 4, 5, 9, 10, 12, 13},
+										{3, 6, 8, 11},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC02_PARAM = {IC_74HC02, 8, 4,
+										{2, 3, 5, 6, 8, 9, 11, 12},
+										{1, 4, 10, 13},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC04_PARAM = {IC_74HC04, 6, 6,
+										{1, 3, 5, 9, 11, 13},
+										{2, 4, 6, 8, 10, 12},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC08_PARAM = {IC_74HC08, 8, 4,
+										{1, 2, 4, 5, 9, 10, 12, 13},
+										{3, 6, 8, 11},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC10_PARAM = {IC_74HC10, 9, 3,
+										{1, 2, 13, 3, 4, 5, 9, 10, 11},
+										{12, 6, 8},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC20_PARAM = {IC_74HC20, 8, 2,
+										{1, 2, 4, 5, 9, 10, 12, 13},
+										{6, 8},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC27_PARAM = {IC_74HC27, 9, 3,
+										{1, 2, 13, 3, 4, 5, 9, 10, 11},
+										{12, 6, 8},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC86_PARAM = {IC_74HC86, 8, 4,
+										{1, 2, 4, 5, 9, 10, 12, 13},
+										{3, 6, 8, 11},
+										IC_CLASS_GATE, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC164_PARAM = {IC_74HC164, 4, 8,
+										{1, 2, 8, 9},
+										{3, 4, 5, 6, 10, 11, 12, 13},
+										IC_CLASS_SHIFT_REGISTER, 0, IC_OUTPUT_PUSH_PULL };
+
+const IC_PARAMETERS_T IC_74HC393_PARAM = {IC_74HC393, 4, 8,
+										{1, 2, 13, 12},
+										{3, 4, 5, 6, 11, 10, 9, 8},
+										IC_CLASS_COUNTER, 0, IC_OUTPUT_PUSH_PULL };
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static CHECKER_RESULT_T checkerResult;
+static uint8_t checkerOscEnable = 0U;
+static uint8_t checkerSignatureEnable = 0U;
+static uint8_t checkerFamilyEnable = 0U;
+static uint8_t checkerIddqEnable = 0U;
+static uint8_t checkerIddqActive = 0U;
+static uint8_t checkerDiagnoseEnable = TRUE;
+static uint8_t checkerLearnEnable = 0U;
+static uint8_t checkerLearnPending = 0U;
+static CHECKER_TIER_T checkerTier = CHECKER_TIER_STANDARD;
+static uint8_t checkerVoteSamples = CHECKER_VOTE_DEFAULT;
+static CHECKER_VOTE_STATS_T checkerVoteStats;
+static CHECKER_DRIVE_T checkerDrive[CHECKER_NUM_DESIGNATORS];
+
+static const SOCKET_SPEED_T checkerSpeeds[CHECKER_NUM_SPEEDS] = {
+	SOCKET_SPEED_LOW, SOCKET_SPEED_MEDIUM, SOCKET_SPEED_HIGH
+};
+static CHECKER_PROGRAM_T checkerProgram;
+static uint16_t checkerSettleOffset[SOCKET_NUM_PINS + 1];
+static CHECKER_FAILURE_T checkerFailure;
+static uint64_t checkerRetestSet;
+static CHECKER_RETEST_T checkerRetestLog[CHECKER_RETEST_LOG_SIZE];
+static uint8_t checkerRetestNext;
+static uint8_t checkerRetestCount;
+
+static const uint8_t checkerAdjacentPins[CHECKER_NUM_ADJACENT][2] = {
+	{1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 6},
+	{8, 9}, {9, 10}, {10, 11}, {11, 12}, {12, 13}
+};
+// Adjacent DIP pin pairs, pins 6-7 and 13-14 bridge to a supply and are
+// stuck-at faults
+
 /******************************************************************************
 * Private Function Prototypes
 ******************************************************************************/
-static void checkerSetClrInputs(uint8_t*, uint8_t, uint8_t, uint8_t);
-static uint8_t checkerReadICOutput(uint8_t);
+static void checkerCompileProgram(IC_PARAMETERS_T*);
+static void checkerOrderProgram(IC_PARAMETERS_T*);
+static void checkerAddBridgeVectors(IC_PARAMETERS_T*);
+static uint32_t checkerBridgeCoverage(IC_PARAMETERS_T*, uint32_t);
+static uint32_t checkerInputsToDrive(IC_PARAMETERS_T*, uint16_t);
+static uint8_t checkerCountBits(uint32_t);
+static uint8_t checkerRunProgram(CHECKER_PASS_T, uint8_t);
+static uint8_t checkerTierVectors(CHECKER_TIER_T);
+static uint16_t checkerMeasureMargin(void);
+static void checkerKeepFailure(IC_PARAMETERS_T*);
+static void checkerSetClrInputs(CHECKER_VECTOR_T*, uint8_t*, uint8_t, uint8_t, uint8_t);
+static uint32_t checkerReadICOutput(void);
+static uint32_t checkerPinsToMask(uint16_t);
+static uint32_t checkerVoteOutput(uint32_t, const CHECKER_VECTOR_T*);
+static uint16_t checkerOpenOutputs(uint32_t);
+static void checkerSettle(uint16_t);
+static uint8_t checkerGateOutput(const IC_PARAMETERS_T*, uint8_t, uint8_t, uint8_t, uint8_t);
 static uint8_t checkerFailTest(IC_DESIGNATOR_T, uint8_t, uint8_t, uint8_t, uint8_t, uint8_t);
 
 /******************************************************************************
@@ -73,11 +309,25 @@ static uint8_t checkerFailTest(IC_DESIGNATOR_T, uint8_t, uint8_t, uint8_t, uint8
 * 08/04/2019:	Anthony Needles
 * 				Ported function for use with LICC v3.0.
 *
+* 08/05/2019:	Anthony Needles
+* 				GPIO clocks enabled through SocketInit. Oscillation
+* 				detector initialized.
+*
+* 08/07/2019:	Anthony Needles
+* 				CRC unit clock enabled for signature mode.
+*
+* 08/23/2019:	Anthony Needles
+* 				IDDQ current sense input initialized.
+*
+* 08/24/2019:	Anthony Needles
+* 				Over-current shutdown initialized.
+*
 * Description:  Enables clocks for GPIO ports A and B. Enables
 * 				TIM17 with count value of desired delays measured
 * 				in cycles. This timer will be used for delaying
 * 				small amounts to ensure any output gate change has
 * 				time to propagate the system. One pulse mode enabled.
+* 				AdcInit must have been called (over-current shutdown).
 *
 * Arguments:    None
 *
@@ -85,12 +335,19 @@ static uint8_t checkerFailTest(IC_DESIGNATOR_T, uint8_t, uint8_t, uint8_t, uint8
 ******************************************************************************/
 void CheckerInit(void)
 {
-	// Enable GPIOA clock and GPIOB clock
-	RCC->AHBENR |= (RCC_AHBENR_GPIOAEN | RCC_AHBENR_GPIOAEN);
+	// Enable GPIOA clock and GPIOB clock, float all socket pins
+	SocketInit();
 	RCC->APB2ENR |= RCC_APB2ENR_TIM17EN;
 
 	TIM17->CR1 |= TIM_CR1_OPM;
 	TIM17->ARR = CYCLES_DELAY;
+
+	RCC->AHBENR |= RCC_AHBENR_CRCEN;
+
+	OscInit();
+	CounterInit();
+	IddqInit();
+	OcInit();
 }
 
 /******************************************************************************
@@ -102,6 +359,43 @@ void CheckerInit(void)
 * 08/04/2019:	Anthony Needles
 * 				Ported function for use with LICC v3.0.
 *
+* 08/05/2019:	Anthony Needles
+* 				Gate loops moved to checkerRunGates. Added result
+* 				record and oscillation post-pass.
+*
+* 08/07/2019:	Anthony Needles
+* 				IC compiled into vector program (cached per IC type).
+* 				Added signature mode.
+*
+* 08/08/2019:	Anthony Needles
+* 				Rejected ICs diagnosed through fault dictionary.
+*
+* 08/10/2019:	Anthony Needles
+* 				Runs the selected test tier.
+*
+* 08/11/2019:	Anthony Needles
+* 				Shift register class ICs handed to ShiftRegTest.
+*
+* 08/12/2019:	Anthony Needles
+* 				Counter class ICs handed to CounterTest.
+*
+* 08/22/2019:	Anthony Needles
+* 				Passing gate ICs optionally classified by logic family.
+*
+* 08/23/2019:	Anthony Needles
+* 				Optional IDDQ screening during the first program pass.
+*
+* 08/24/2019:	Anthony Needles
+* 				Supply current monitored throughout, an over-current
+* 				shutdown abandons the test.
+*
+* 08/27/2019:	Anthony Needles
+* 				Failing vectors kept for CheckerRetestFailures.
+*
+* 08/28/2019:	Anthony Needles
+* 				Die temperature and VDDA taken from the background
+* 				averages before the ADC is taken for the test.
+*
 * Description:  Main test structure. Performs testing by creating all
 * 				possible input combinations and reading resulting outputs.
 * 				Made generically for any boolean logic 74HCXX IC with
@@ -110,7 +404,21 @@ void CheckerInit(void)
 * 				the loops for unused inputs are bypassed (e.g. two
 * 				input gates will only use A and B loops). Only required
 * 				input pins are set/cleared. If tests fails at any point
-* 				failure result is immediately sent.
+* 				failure result is immediately sent. In signature mode the
+* 				outputs of every vector are compacted by the CRC unit and
+* 				compared once against the golden signature, and only a
+* 				mismatch runs the per-vector diagnostic path. Rejected ICs
+* 				optionally have every vector rerun to collect the full
+* 				failing vector set, which is looked up in the fault
+* 				dictionary to name the likely defect. Passing ICs
+* 				optionally run the oscillation post-pass. Only the vector
+* 				prefix of the selected tier is run, the full and
+* 				characterize tiers then check the outputs for high-Z and
+* 				characterize measures delay and settle margin. Shift
+* 				registers and counters are instead clocked through their
+* 				shift pattern or count sequence (see ShiftReg.c and
+* 				Counter.c), with the failing step as the failing vector.
+* 				All socket pins are floated once testing is complete.
 *
 * Arguments:    IC_PARAMETERS_T IC - Structure holding IC parameters
 *
@@ -118,267 +426,1693 @@ void CheckerInit(void)
 ******************************************************************************/
 uint8_t CheckerTestIC(IC_PARAMETERS_T IC)
 {
-	uint8_t num_gates = IC.num_outputs;
-	uint8_t num_inputs_gate = IC.num_inputs/IC.num_outputs;
-	uint8_t loop_skip_field = (0xFF << num_inputs_gate);
-	uint8_t gate_start_index = 0;
-	uint8_t test_output;
-	uint8_t fail_result;
-	uint8_t gate_num;
+	uint8_t test_result;
+	uint8_t num_vectors;
 
-	for(gate_num = 0; gate_num < num_gates; gate_num++){
-		for(uint8_t gate_input_A = INPUT_A_LOOP_SKIP; gate_input_A < 2; gate_input_A++){
-			for(uint8_t gate_input_B = INPUT_B_LOOP_SKIP; gate_input_B < 2; gate_input_B++){
-				for(uint8_t gate_input_C = INPUT_C_LOOP_SKIP; gate_input_C < 2; gate_input_C++){
-					for(uint8_t gate_input_D = INPUT_D_LOOP_SKIP; gate_input_D < 2; gate_input_D++){
-						if(INPUT_A_LOOP_SKIP != TRUE) checkerSetClrInputs(IC.input_pins, gate_start_index, 0, gate_input_A);
-						if(INPUT_B_LOOP_SKIP != TRUE) checkerSetClrInputs(IC.input_pins, gate_start_index, 1, gate_input_B);
-						if(INPUT_C_LOOP_SKIP != TRUE) checkerSetClrInputs(IC.input_pins, gate_start_index, 2, gate_input_C);
-						if(INPUT_D_LOOP_SKIP != TRUE) checkerSetClrInputs(IC.input_pins, gate_start_index, 3, gate_input_D);
+	checkerResult.ic_designator = IC.ic_designator;
+	checkerResult.osc_pins = 0U;
+	checkerResult.fail_vector = CHECKER_NO_VECTOR;
+	checkerResult.sig_mismatch = 0U;
+	checkerResult.fail_set = 0U;
+	checkerResult.fault = FAULT_NONE;
+	checkerResult.fault_candidates = 0U;
+	checkerResult.tier = checkerTier;
+	checkerResult.hiz_pins = 0U;
+	checkerResult.max_delay_cycles = 0U;
+	checkerResult.min_settle_cycles = 0U;
+	checkerResult.family = FAMILY_UNKNOWN;
+	checkerResult.iddq_ua = 0U;
+	checkerResult.iddq_vector = IDDQ_NO_VECTOR;
+	checkerResult.overcurrent = 0U;
+	checkerFailure.valid = 0U;
+	CondGet(&checkerResult.temp_dc, &checkerResult.vdda_mv);
 
-						test_output = checkerReadICOutput(IC.output_pins[gate_num]);
+	OcArm();
 
-						fail_result = checkerFailTest(IC.ic_designator, test_output, gate_input_A, gate_input_B, gate_input_C, gate_input_D);
+	if(IC.ic_class != IC_CLASS_GATE){
+		if(IC.ic_class == IC_CLASS_SHIFT_REGISTER){
+			test_result = ShiftRegTest(&IC, &checkerResult.fail_vector);
+			checkerResult.vectors_run = SHIFT_NUM_CLOCKS + 2U;
+		} else {
+			test_result = CounterTest(&IC, &checkerResult.fail_vector);
+			checkerResult.vectors_run = (IC.num_inputs / 2U) * (1U + COUNTER_MAX_EDGES);
+		}
+		if(test_result == PASSED) checkerResult.fail_vector = CHECKER_NO_VECTOR;
+		if(OcTripped() == TRUE){
+			checkerResult.overcurrent = TRUE;
+			test_result = FAILED;
+		}
 
-						if(fail_result == FAILED) return FAILED;
-					}
-				}
+		OcDisarm();
+		SocketFloat();
+		checkerResult.passed = test_result;
+		return test_result;
+	}
+
+	if((checkerProgram.valid != TRUE) || (checkerProgram.ic_designator != IC.ic_designator)){
+		checkerCompileProgram(&IC);
+	}
+	num_vectors = checkerTierVectors(checkerTier);
+	checkerResult.vectors_run = num_vectors;
+
+	// Supply current is sampled during the first pass over the program only
+	if(checkerIddqEnable == TRUE){
+		IddqStart(num_vectors);
+		checkerIddqActive = TRUE;
+	}
+
+	if(checkerSignatureEnable == TRUE){
+		test_result = checkerRunProgram(CHECKER_PASS_SIGNATURE, num_vectors);
+		checkerIddqActive = 0U;
+
+		// Mismatch falls back to per-vector compare to find the failing vector
+		if(test_result == FAILED){
+			checkerResult.sig_mismatch = TRUE;
+			test_result = checkerRunProgram(CHECKER_PASS_FUNCTIONAL, num_vectors);
+		}
+	} else {
+		test_result = checkerRunProgram(CHECKER_PASS_FUNCTIONAL, num_vectors);
+	}
+
+	if(checkerIddqEnable == TRUE){
+		checkerIddqActive = 0U;
+		if((IddqFinish(IC.ic_designator, &checkerResult.iddq_ua, &checkerResult.iddq_vector) == FAILED)
+		   && (test_result == PASSED)){
+			test_result = FAILED;
+		}
+		OcResume();
+	}
+
+	// Socket was floated by an over-current, it must not be driven again
+	if(OcTripped() == TRUE){
+		OcDisarm();
+		SocketFloat();
+		checkerResult.overcurrent = TRUE;
+		checkerResult.passed = FAILED;
+		return FAILED;
+	}
+
+	// High-Z check with the last vector still applied
+	if((test_result == PASSED) && (checkerTier >= CHECKER_TIER_FULL)){
+		checkerResult.hiz_pins = checkerOpenOutputs(checkerProgram.vectors[num_vectors - 1U].expect);
+		if(checkerResult.hiz_pins != 0U) test_result = FAILED;
+	}
+
+	if((test_result == PASSED) && (checkerTier == CHECKER_TIER_CHARACTERIZE)){
+		checkerRunProgram(CHECKER_PASS_TIMING, num_vectors);
+		checkerResult.min_settle_cycles = checkerMeasureMargin();
+	}
+
+	// Diagnosis only runs on rejects, passing ICs are never slowed by it
+	if((test_result == FAILED) && (checkerDiagnoseEnable == TRUE)){
+		checkerRunProgram(CHECKER_PASS_DIAGNOSTIC, checkerProgram.num_vectors);
+		checkerResult.fault = FaultDictLookup(&IC, checkerResult.fail_set, checkerOpenOutputs(checkerProgram.vectors[checkerProgram.num_vectors - 1U].expect),
+											  &checkerResult.fault_candidates);
+
+		// Only faults the ordering can simulate are worth logging
+		if((checkerLearnEnable == TRUE) && (FAULT_TYPE(checkerResult.fault) >= FAULT_STUCK_LOW)
+		   && (FAULT_TYPE(checkerResult.fault) <= FAULT_BRIDGE)){
+			FailLogRecord(IC.ic_designator, checkerResult.fault);
+			if(++checkerLearnPending >= CHECKER_REORDER_INTERVAL){
+				checkerLearnPending = 0U;
+				checkerProgram.valid = 0U;
 			}
 		}
-		gate_start_index += num_inputs_gate;
 	}
-	return PASSED;
+
+	// Oscillation post-pass only runs on functionally passing ICs so it
+	// never adds to reject time
+	if((test_result == PASSED) && (checkerOscEnable == TRUE)){
+		OscReset();
+		checkerRunProgram(CHECKER_PASS_OSCILLATION, num_vectors);
+		checkerResult.osc_pins = OscGetFlaggedPins();
+		if(checkerResult.osc_pins != 0U) test_result = FAILED;
+	}
+
+	// Family is only reported, HC, HCT and LS parts all pass
+	if((test_result == PASSED) && (checkerFamilyEnable == TRUE)){
+		checkerResult.family = FamilyClassify(&IC)->family;
+	}
+
+	if(OcTripped() == TRUE){
+		checkerResult.overcurrent = TRUE;
+		test_result = FAILED;
+	}
+	else if(test_result == FAILED){
+		checkerKeepFailure(&IC);
+	}
+
+	OcDisarm();
+	SocketFloat();
+	checkerResult.passed = test_result;
+	return test_result;
 }
 
 /******************************************************************************
-* checkerSetClrInputs - Private Function
+* CheckerRetestFailures - Public Function
 *
-* 12/09/2018:	Anthony Needles
+* 08/27/2019:	Anthony Needles
 * 				Started and completed function.
 *
-* 08/04/2019:	Anthony Needles
-* 				Ported function for use with LICC v3.0.
+* Description:  Replays the vectors the last rejected gate IC failed on,
+* 				found through their gate loop order index so a program
+* 				reordered or recompiled since still replays the same
+* 				vectors. The settle time is lengthened for the replay
+* 				only. Each vector is replayed with every input at the
+* 				level it had in the original run (see checkerRunProgram),
+* 				so a bridge to a neighbouring gate is retested as it was
+* 				tested. Voting and over-current shutdown apply as in the
+* 				test. The outcome is logged against the original failure
+* 				whether it passed or not.
 *
-* Description:  Handed input pin number array for given IC, whether to
-* 				set or clear, the index the current gate input group is
-* 				located in the pin number array, and which number input
-* 				of the gate is specified. This function derives
-* 				which specific IC pin is desired to set/clear based on
-* 				passed specifications.
+* Arguments:    uint16_t extra_settle_cycles - SYSCLK cycles added to the
+* 				settle time of every replayed vector
 *
-* Arguments:    uint8_t *input_pins - Input IC pin number array (in
-* 				order) for tested IC.
+* Return:		PASSED if every replayed vector passed, FAILED if any still
+* 				fail, CHECKER_NO_RETEST if there is no failure to retest
+******************************************************************************/
+uint8_t CheckerRetestFailures(uint16_t extra_settle_cycles)
+{
+	CHECKER_RETEST_T *entry;
+	uint16_t settle_cycles;
+	uint64_t still_failing;
+	uint8_t num_retested = 0U;
+
+	if(checkerFailure.valid != TRUE) return CHECKER_NO_RETEST;
+
+	CheckerGetProgram(&checkerFailure.IC);
+	checkerRetestSet = 0U;
+	for(uint8_t index = 0; index < checkerProgram.num_vectors; index++){
+		if((checkerFailure.vector_ids >> checkerProgram.vector_id[index]) & 1U){
+			checkerRetestSet |= ((uint64_t)1U << index);
+			num_retested++;
+		}
+	}
+
+	settle_cycles = checkerProgram.settle_cycles;
+	checkerProgram.settle_cycles = (extra_settle_cycles > (CHECKER_MAX_SETTLE - settle_cycles))
+								   ? CHECKER_MAX_SETTLE : (settle_cycles + extra_settle_cycles);
+
+	OcArm();
+	checkerRunProgram(CHECKER_PASS_RETEST, checkerProgram.num_vectors);
+	still_failing = checkerRetestSet;
+	OcDisarm();
+	SocketFloat();
+	checkerProgram.settle_cycles = settle_cycles;
+
+	entry = &checkerRetestLog[checkerRetestNext];
+	checkerRetestNext = (checkerRetestNext + 1U) % CHECKER_RETEST_LOG_SIZE;
+	if(checkerRetestCount < CHECKER_RETEST_LOG_SIZE) checkerRetestCount++;
+
+	entry->ic_designator = checkerFailure.IC.ic_designator;
+	entry->fault = checkerFailure.fault;
+	entry->fail_vector = checkerFailure.fail_vector;
+	entry->attempt = ++checkerFailure.attempts;
+	entry->extra_settle_cycles = extra_settle_cycles;
+	entry->num_retested = num_retested;
+	entry->num_failing = 0U;
+	for(uint8_t index = 0; index < checkerProgram.num_vectors; index++){
+		if((still_failing >> index) & 1U) entry->num_failing++;
+	}
+	if(OcTripped() == TRUE) entry->num_failing = num_retested;
+	entry->passed = (entry->num_failing == 0U) ? PASSED : FAILED;
+
+	return entry->passed;
+}
+
+/******************************************************************************
+* CheckerGetRetestLog - Public Function
 *
-* 				uint8_t gate_start - Index of pin number array that
-* 				current input group starts.
+* 08/27/2019:	Anthony Needles
+* 				Started and completed function.
 *
-* 				uint8_t input_offset - Offset of specific pin in input
-* 				group that is desired to be set/cleared.
+* Description:  Gives read access to the retest log, newest first.
 *
-* 				uint8_t input_value - Desired value to give to input
-* 				pin (1 for set, 0 for clear).
+* Arguments:    uint8_t age - 0 for the latest retest, up to
+* 				CHECKER_RETEST_LOG_SIZE - 1
 *
-* Return:		None
+* Return:		Pointer to retest outcome, 0 if not that many logged
 ******************************************************************************/
-void checkerSetClrInputs(uint8_t *input_pins, uint8_t gate_start, uint8_t input_offset, uint8_t input_state)
+const CHECKER_RETEST_T *CheckerGetRetestLog(uint8_t age)
 {
-	uint8_t ic_pin = input_pins[gate_start + input_offset];
-
-	switch(ic_pin){
-	case 1:
-		GPIOB->MODER &= ~GPIO_MODER_MODER11_Msk;
-		GPIOB->MODER |= GPIO_MODER_MODER11_0;
-		(input_state == SET) ? (GPIOB->ODR |= GPIO_ODR_11) : (GPIOB->ODR &= ~GPIO_ODR_11);
-	break;
-
-	case 2:
-		GPIOB->MODER &= ~GPIO_MODER_MODER10_Msk;
-		GPIOB->MODER |= GPIO_MODER_MODER10_0;
-		(input_state == SET) ? (GPIOB->ODR |= GPIO_ODR_10) : (GPIOB->ODR &= ~GPIO_ODR_10);
-	break;
-
-	case 3:
-		GPIOB->MODER &= ~GPIO_MODER_MODER2_Msk;
-		GPIOB->MODER |= GPIO_MODER_MODER2_0;
-		(input_state == SET) ? (GPIOB->ODR |= GPIO_ODR_2) : (GPIOB->ODR &= ~GPIO_ODR_2);
-	break;
-
-	case 4:
-		GPIOB->MODER &= ~GPIO_MODER_MODER1_Msk;
-		GPIOB->MODER |= GPIO_MODER_MODER1_0;
-		(input_state == SET) ? (GPIOB->ODR |= GPIO_ODR_1) : (GPIOB->ODR &= ~GPIO_ODR_1);
-	break;
-
-	case 5:
-		GPIOB->MODER &= ~GPIO_MODER_MODER0_Msk;
-		GPIOB->MODER |= GPIO_MODER_MODER0_0;
-		(input_state == SET) ? (GPIOB->ODR |= GPIO_ODR_0) : (GPIOB->ODR &= ~GPIO_ODR_0);
-	break;
-
-	case 6:
-		GPIOA->MODER &= ~GPIO_MODER_MODER7_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER7_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_7) : (GPIOA->ODR &= ~GPIO_ODR_7);
-	break;
-
-	case 8:
-		GPIOA->MODER &= ~GPIO_MODER_MODER6_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER6_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_6) : (GPIOA->ODR &= ~GPIO_ODR_6);
-	break;
-
-	case 9:
-		GPIOA->MODER &= ~GPIO_MODER_MODER5_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER5_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_5) : (GPIOA->ODR &= ~GPIO_ODR_5);
-	break;
-
-	case 10:
-		GPIOA->MODER &= ~GPIO_MODER_MODER4_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER4_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_4) : (GPIOA->ODR &= ~GPIO_ODR_4);
-	break;
-
-	case 11:
-		GPIOA->MODER &= ~GPIO_MODER_MODER3_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER3_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_3) : (GPIOA->ODR &= ~GPIO_ODR_3);
-	break;
-
-	case 12:
-		GPIOA->MODER &= ~GPIO_MODER_MODER2_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER2_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_2) : (GPIOA->ODR &= ~GPIO_ODR_2);
-	break;
-
-	case 13:
-		GPIOA->MODER &= ~GPIO_MODER_MODER1_Msk;
-		GPIOA->MODER |= GPIO_MODER_MODER1_0;
-		(input_state == SET) ? (GPIOA->ODR |= GPIO_ODR_1) : (GPIOA->ODR &= ~GPIO_ODR_1);
-	break;
+	if(age >= checkerRetestCount) return 0;
+	return &checkerRetestLog[(checkerRetestNext + CHECKER_RETEST_LOG_SIZE - 1U - age) % CHECKER_RETEST_LOG_SIZE];
+}
 
-	default:
-	break;
-	}
+/******************************************************************************
+* CheckerSetOscillationCheck - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  When enabled, ICs that pass the functional test have
+* 				every gate input combination applied again while each
+* 				output is sampled throughout the settle window (see
+* 				Oscillation.c). Any oscillating output fails the IC.
+* 				Rejected ICs never run the post-pass.
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetOscillationCheck(uint8_t enable)
+{
+	checkerOscEnable = (enable != 0U) ? TRUE : 0U;
 }
 
 /******************************************************************************
-* checkerReadICOutput - Private Function
+* CheckerSetFamilyCheck - Public Function
 *
-* 12/09/2018:	Anthony Needles
+* 08/22/2019:	Anthony Needles
 * 				Started and completed function.
 *
-* 08/04/2019:	Anthony Needles
-* 				Ported function for use with LICC v3.0.
+* Description:  When enabled, gate ICs that pass have their logic family
+* 				(HC, HCT or LS) classified from input thresholds and output
+* 				levels (see Family.c), ~2ms per IC. The family is reported
+* 				in the result record and does not affect pass/fail.
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetFamilyCheck(uint8_t enable)
+{
+	checkerFamilyEnable = (enable != 0U) ? TRUE : 0U;
+}
+
+/******************************************************************************
+* CheckerSetIddqCheck - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
 *
-* Description:  Based on which pin number given from specific IC's
-* 				output pin array, corresponding GPIO port is set to
-* 				input mode (relative to MCU, but these pins will be
-* 				outputs relative to the tested IC). TIM17 is enabled
-* 				and has update interrupt flag polled in order to
-* 				generate a delay of only a few clock cycles. This allows
-* 				any gate output changes time to propagate so that
-* 				readings are correct. The resulting read logic level
-* 				is then returned.
+* Description:  When enabled, the supply current of every gate IC vector
+* 				is sampled at the end of its settle window during the
+* 				first pass over the program (see Iddq.c). An IC drawing
+* 				more than its limit on any vector fails, the worst current
+* 				and its vector are kept in the result record.
 *
-* Arguments:    uint8_t ic_pin - IC pin desired to have logic level read
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
 *
-* Return:		Logic value read from GPIO input
+* Return:		None
 ******************************************************************************/
-uint8_t checkerReadICOutput(uint8_t ic_pin)
+void CheckerSetIddqCheck(uint8_t enable)
 {
-	uint8_t ret_val;
+	checkerIddqEnable = (enable != 0U) ? TRUE : 0U;
+}
 
-	switch(ic_pin){
-	case 1:
-		GPIOB->MODER &= ~(GPIO_MODER_MODER11);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOB->IDR & GPIO_IDR_11) >> 10);
-		break;
+/******************************************************************************
+* CheckerSetSignatureMode - Public Function
+*
+* 08/07/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  When enabled, CheckerTestIC feeds the packed output word
+* 				of every vector into the hardware CRC unit instead of
+* 				comparing each vector, then makes a single compare against
+* 				the golden signature of the IC. A mismatch reruns the
+* 				per-vector compare to find the failing vector.
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetSignatureMode(uint8_t enable)
+{
+	checkerSignatureEnable = (enable != 0U) ? TRUE : 0U;
+}
 
-	case 2:
-		GPIOB->MODER &= ~(GPIO_MODER_MODER10);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		return ((GPIOB->IDR & GPIO_IDR_10) >> 3);
-		break;
+/******************************************************************************
+* CheckerSetDiagnosis - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  When enabled (default), a rejected IC has every vector
+* 				rerun to collect its failing vector set, and the fault
+* 				dictionary lookup result is placed in the result record.
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetDiagnosis(uint8_t enable)
+{
+	checkerDiagnoseEnable = (enable != 0U) ? TRUE : 0U;
+}
 
-	case 3:
-		GPIOB->MODER &= ~(GPIO_MODER_MODER2);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOB->IDR & GPIO_IDR_2) >> 5);
-		break;
+/******************************************************************************
+* CheckerSetLearning - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  When enabled, the fault diagnosed on every rejected IC
+* 				is logged to flash and the vector order of each IC is
+* 				weighted by how often each fault has been seen. The order
+* 				is recomputed every CHECKER_REORDER_INTERVAL logged faults.
+* 				Requires diagnosis to be enabled. Disabled by default,
+* 				vectors are then ordered by stuck-at coverage alone.
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetLearning(uint8_t enable)
+{
+	checkerLearnEnable = (enable != 0U) ? TRUE : 0U;
+	checkerProgram.valid = 0U;
+}
 
-	case 4:
-		GPIOB->MODER &= ~(GPIO_MODER_MODER1);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOB->IDR & GPIO_IDR_1) >> 4);
-		break;
+/******************************************************************************
+* CheckerSetTier - Public Function
+*
+* 08/10/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Selects the test tier run by CheckerTestIC (see
+* 				CHECKER_TIER_T). Standard by default.
+*
+* Arguments:    CHECKER_TIER_T tier - Test tier
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetTier(CHECKER_TIER_T tier)
+{
+	if(tier <= CHECKER_TIER_CHARACTERIZE) checkerTier = tier;
+}
 
-	case 5:
-		GPIOB->MODER &= ~(GPIO_MODER_MODER0);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOB->IDR & GPIO_IDR_0) >> 10);
-		break;
+/******************************************************************************
+* CheckerGetTierInfo - Public Function
+*
+* 08/10/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Shift register estimate uses the IC settle time.
+*
+* 08/31/2019:	Anthony Needles
+* 				Counter estimate uses the IC settle time.
+*
+* Description:  Compiles the IC if required and fills in the number of
+* 				vectors the tier runs on it and an estimate of how long
+* 				a passing IC takes to test at that tier (shift registers
+* 				and counters have a single level). Each vector costs
+* 				its settle time plus CHECKER_VECTOR_OVERHEAD, the high-Z
+* 				check costs two settled reads, and characterize adds a
+* 				timing pass plus one functional pass per margin search
+* 				step (assuming every step passes, the longest case).
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				CHECKER_TIER_T tier - Test tier
+*
+* 				CHECKER_TIER_INFO_T *info - Filled in with tier info
+*
+* Return:		None
+******************************************************************************/
+void CheckerGetTierInfo(IC_PARAMETERS_T *IC, CHECKER_TIER_T tier, CHECKER_TIER_INFO_T *info)
+{
+	uint32_t vector_cycles;
+	uint32_t cycles;
+	uint16_t low = 0U;
+	uint16_t high;
 
-	case 6:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER7);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_7) >> 8);
-		break;
+	// Shift registers always run the whole shift pattern, two edges a clock
+	if(IC->ic_class == IC_CLASS_SHIFT_REGISTER){
+		info->num_vectors = SHIFT_NUM_CLOCKS + 2U;
+		info->duration_us = (((2U * SHIFT_NUM_CLOCKS) + 2U) * ((uint32_t)CheckerGetSettle(IC) + CHECKER_VECTOR_OVERHEAD))
+							/ (TIMESTAMP_CLK_HZ / 1000000U);
+		return;
+	}
 
-	case 8:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER6);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_6) >> 9);
-		break;
+	// Counters run every section through at most COUNTER_MAX_EDGES edges
+	if(IC->ic_class == IC_CLASS_COUNTER){
+		info->num_vectors = (IC->num_inputs / 2U) * (1U + COUNTER_MAX_EDGES);
+		info->duration_us = (IC->num_inputs / 2U) * ((2U * (uint32_t)CheckerGetSettle(IC))
+							+ (COUNTER_MAX_EDGES * ((uint32_t)CheckerGetSettle(IC) + COUNTER_SAMPLE_MARGIN)))
+							/ (TIMESTAMP_CLK_HZ / 1000000U);
+		return;
+	}
 
-	case 9:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER5);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_5) >> 7);
-		break;
+	CheckerGetProgram(IC);
+	vector_cycles = checkerProgram.settle_cycles + CHECKER_VECTOR_OVERHEAD;
 
-	case 10:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER4);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_4) >> 6);
-		break;
+	info->num_vectors = checkerTierVectors(tier);
+	cycles = info->num_vectors * vector_cycles;
 
-	case 11:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER3);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_3) >> 7);
-		break;
+	if(tier >= CHECKER_TIER_FULL) cycles += 2U * vector_cycles;
 
-	case 12:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER2);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_2) >> 6);
-		break;
+	if(tier == CHECKER_TIER_CHARACTERIZE){
+		cycles += info->num_vectors * (CHECKER_TIMING_LIMIT + CHECKER_VECTOR_OVERHEAD);
+		for(high = checkerProgram.settle_cycles; (uint16_t)(high - low) > CHECKER_MARGIN_RESOLUTION; high = (low + high) >> 1){
+			cycles += info->num_vectors * ((((low + high) >> 1) + CHECKER_VECTOR_OVERHEAD));
+		}
+	}
 
-	case 13:
-		GPIOA->MODER &= ~(GPIO_MODER_MODER1);
-		TIM17->CR1 |= TIM_CR1_CEN;
-		while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
-		ret_val = ((GPIOA->IDR & GPIO_IDR_1) >> 5);
-		break;
+	info->duration_us = cycles / (TIMESTAMP_CLK_HZ / 1000000U);
+}
 
-	default:
-		ret_val = 0xFF;
-		break;
+/******************************************************************************
+* CheckerGetProgram - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the compiled vector program of the
+* 				given IC, compiling it first if a different IC (or none)
+* 				is currently compiled.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		Pointer to compiled program
+******************************************************************************/
+const CHECKER_PROGRAM_T *CheckerGetProgram(IC_PARAMETERS_T *IC)
+{
+	if((checkerProgram.valid != TRUE) || (checkerProgram.ic_designator != IC->ic_designator)){
+		checkerCompileProgram(IC);
 	}
-	return ret_val;
+	return &checkerProgram;
+}
+
+/******************************************************************************
+* CheckerEvaluate - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Input pin array only indexed for inputs the gate has, the
+* 				last gate of 2 and 3 input ICs read past its end.
+*
+* Description:  Computes the output levels of every gate of the IC for a
+* 				given set of input levels, using the IC failure boolean
+* 				functions (or the truth table of a user IC). Unused gate
+* 				inputs are treated as set, the same as the gate loops.
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint32_t inputs - Packed socket word of input levels
+*
+* Return:		Packed socket word of expected output levels
+******************************************************************************/
+uint32_t CheckerEvaluate(const IC_PARAMETERS_T *IC, uint32_t inputs)
+{
+	uint8_t num_inputs_gate = IC->num_inputs/IC->num_outputs;
+	uint8_t gate_in[4];
+	uint32_t outputs = 0U;
+	uint8_t ic_pin;
+
+	for(uint8_t gate_num = 0; gate_num < IC->num_outputs; gate_num++){
+		for(uint8_t input = 0; input < 4; input++){
+			gate_in[input] = 1U;
+			if(input < num_inputs_gate){
+				ic_pin = IC->input_pins[(gate_num * num_inputs_gate) + input];
+				if((ic_pin > SOCKET_NUM_PINS) || ((inputs & SocketPinMask[ic_pin]) == 0U)) gate_in[input] = 0U;
+			}
+		}
+
+		ic_pin = IC->output_pins[gate_num];
+		if((ic_pin <= SOCKET_NUM_PINS)
+		   && (checkerGateOutput(IC, gate_in[0], gate_in[1], gate_in[2], gate_in[3]) == SET)){
+			outputs |= SocketPinMask[ic_pin];
+		}
+	}
+	return outputs;
+}
+
+/******************************************************************************
+* CheckerSetSettleOffset - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the extra settle time added to CYCLES_DELAY when
+* 				reading the given IC pin. Used to compensate for slow
+* 				socket contacts found by fixture calibration.
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* 				uint16_t cycles - Extra settle time in SYSCLK cycles
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetSettleOffset(uint8_t ic_pin, uint16_t cycles)
+{
+	if(ic_pin <= SOCKET_NUM_PINS) checkerSettleOffset[ic_pin] = cycles;
+
+	// Settle time is folded into the program when compiled
+	checkerProgram.valid = 0U;
+}
+
+/******************************************************************************
+* CheckerGetSettle - Public Function
+*
+* 08/30/2019:	Anthony Needles
+* 				Started and completed function (from
+* 				checkerCompileProgram).
+*
+* Description:  Gives the settle time used when reading the outputs of the
+* 				IC: the drive profile base settle time (or CYCLES_DELAY)
+* 				plus the largest calibration offset of its output pins.
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		Settle time in SYSCLK cycles
+******************************************************************************/
+uint16_t CheckerGetSettle(const IC_PARAMETERS_T *IC)
+{
+	const CHECKER_DRIVE_T *drive = &checkerDrive[IC->ic_designator % CHECKER_NUM_DESIGNATORS];
+	uint16_t max_offset = 0U;
+
+	for(uint8_t index = 0; index < IC->num_outputs; index++){
+		if(IC->output_pins[index] > SOCKET_NUM_PINS) continue;
+		if(checkerSettleOffset[IC->output_pins[index]] > max_offset) max_offset = checkerSettleOffset[IC->output_pins[index]];
+	}
+	return ((drive->settle_cycles != 0U) ? drive->settle_cycles : CYCLES_DELAY) + max_offset;
+}
+
+/******************************************************************************
+* CheckerInvalidateProgram - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Discards the compiled vector program, so the next test
+* 				compiles it again. Used when an IC definition changes.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CheckerInvalidateProgram(void)
+{
+	checkerProgram.valid = 0U;
+}
+
+/******************************************************************************
+* CheckerSetVoteSamples - Public Function
+*
+* 08/19/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  When an output read disagrees with the expected level the
+* 				outputs are sampled this many more times and each output
+* 				takes the majority level before the vector is failed.
+* 				Reads that agree cost nothing extra. 0 disables voting.
+* 				An odd count is rounded down so ties cannot occur.
+*
+* Arguments:    uint8_t extra_samples - Extra samples (even, up to
+* 				CHECKER_VOTE_MAX)
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetVoteSamples(uint8_t extra_samples)
+{
+	if(extra_samples > CHECKER_VOTE_MAX) extra_samples = CHECKER_VOTE_MAX;
+	checkerVoteSamples = extra_samples & ~1U;
+}
+
+/******************************************************************************
+* CheckerGetVoteStats - Public Function
+*
+* 08/19/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the counts of votes taken and of
+* 				votes that overturned the first sample.
+*
+* Arguments:    None
+*
+* Return:		Pointer to vote counters
+******************************************************************************/
+const CHECKER_VOTE_STATS_T *CheckerGetVoteStats(void)
+{
+	return &checkerVoteStats;
+}
+
+/******************************************************************************
+* CheckerClearVoteStats - Public Function
+*
+* 08/19/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears the majority vote counters.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CheckerClearVoteStats(void)
+{
+	checkerVoteStats.votes = 0U;
+	checkerVoteStats.overturned = 0U;
+}
+
+/******************************************************************************
+* CheckerSetDrive - Public Function
+*
+* 08/20/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Profile indexed the same way as everywhere else it is
+* 				read.
+*
+* Description:  Sets the drive profile applied every time the IC is tested
+* 				(see CHECKER_DRIVE_T).
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to set profile of
+*
+* 				const CHECKER_DRIVE_T *drive - Drive profile
+*
+* Return:		None
+******************************************************************************/
+void CheckerSetDrive(IC_DESIGNATOR_T ic_designator, const CHECKER_DRIVE_T *drive)
+{
+	checkerDrive[ic_designator % CHECKER_NUM_DESIGNATORS] = *drive;
+
+	// Settle time is folded into the program when compiled
+	if(checkerProgram.ic_designator == ic_designator) checkerProgram.valid = 0U;
+}
+
+/******************************************************************************
+* CheckerGetDrive - Public Function
+*
+* 08/31/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the drive profile of an IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to get profile of
+*
+* Return:		Pointer to drive profile
+******************************************************************************/
+const CHECKER_DRIVE_T *CheckerGetDrive(IC_DESIGNATOR_T ic_designator)
+{
+	return &checkerDrive[ic_designator % CHECKER_NUM_DESIGNATORS];
+}
+
+/******************************************************************************
+* CheckerMeasureDrive - Public Function
+*
+* 08/20/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Run on a known-good part. For every output speed, keeping
+* 				the rest of the IC drive profile and nominal settle time,
+* 				runs every vector once counting misreads caught by the
+* 				majority vote, then searches for the shortest settle time
+* 				the IC passes with (as the characterize tier does). Faster
+* 				edges settle sooner until ringing causes misreads, so the
+* 				speed to use is the one with the shortest settle time that
+* 				passed with no misreads. Its settle time plus a guard band
+* 				is a sensible drive profile settle_cycles. The profile is
+* 				restored afterwards.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				CHECKER_DRIVE_RESULT_T *results - CHECKER_NUM_SPEEDS
+* 				results, slowest speed first
+*
+* Return:		Index of the speed with the shortest settle time that
+* 				passed with no misreads, CHECKER_NO_DRIVE if none did
+******************************************************************************/
+uint8_t CheckerMeasureDrive(IC_PARAMETERS_T *IC, CHECKER_DRIVE_RESULT_T *results)
+{
+	CHECKER_DRIVE_T *drive = &checkerDrive[IC->ic_designator % CHECKER_NUM_DESIGNATORS];
+	CHECKER_DRIVE_T saved = *drive;
+	CHECKER_VOTE_STATS_T votes_before;
+	uint8_t best = CHECKER_NO_DRIVE;
+
+	if(IC->ic_class != IC_CLASS_GATE) return CHECKER_NO_DRIVE;
+
+	for(uint8_t index = 0; index < CHECKER_NUM_SPEEDS; index++){
+		drive->speed = checkerSpeeds[index];
+		drive->settle_cycles = 0U;
+		checkerCompileProgram(IC);
+
+		votes_before = checkerVoteStats;
+		results[index].speed = checkerSpeeds[index];
+		results[index].passed = checkerRunProgram(CHECKER_PASS_FUNCTIONAL, checkerProgram.num_vectors);
+		results[index].votes = checkerVoteStats.votes - votes_before.votes;
+		results[index].overturned = checkerVoteStats.overturned - votes_before.overturned;
+		results[index].min_settle_cycles = (results[index].passed == PASSED) ? checkerMeasureMargin() : 0U;
+
+		if((results[index].passed == PASSED) && (results[index].votes == 0U)
+		   && ((best == CHECKER_NO_DRIVE) || (results[index].min_settle_cycles < results[best].min_settle_cycles))){
+			best = index;
+		}
+	}
+
+	*drive = saved;
+	checkerProgram.valid = 0U;
+	SocketFloat();
+	return best;
+}
+
+/******************************************************************************
+* CheckerGetResult - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the result record filled in by
+* 				the last CheckerTestIC call.
+*
+* Arguments:    None
+*
+* Return:		Pointer to result record
+******************************************************************************/
+const CHECKER_RESULT_T *CheckerGetResult(void)
+{
+	return &checkerResult;
+}
+
+/******************************************************************************
+* checkerCompileProgram - Private Function
+*
+* 12/09/2018:	Anthony Needles
+* 				Started and completed function (as CheckerTestIC loop).
+*
+* 08/05/2019:	Anthony Needles
+* 				Loop moved out of CheckerTestIC so it can be shared by
+* 				the functional test and the oscillation post-pass.
+*
+* 08/07/2019:	Anthony Needles
+* 				Loop now builds the vector program instead of driving
+* 				pins directly. Golden signature computed here.
+*
+* 08/09/2019:	Anthony Needles
+* 				Vectors reordered by fault detection likelihood.
+*
+* 08/10/2019:	Anthony Needles
+* 				All-gate vectors appended for full tier. Golden signature
+* 				computed for each tier.
+*
+* 08/20/2019:	Anthony Needles
+* 				Base settle time taken from the IC drive profile.
+*
+* 08/25/2019:	Anthony Needles
+* 				Bridging vectors added before ordering.
+*
+* 08/26/2019:	Anthony Needles
+* 				Open-drain output pins kept for the program runs.
+*
+* 08/30/2019:	Anthony Needles
+* 				Settle time taken from CheckerGetSettle.
+*
+* Description:  Creates all possible input combinations for every gate
+* 				of the IC, one vector per combination. Loops for unused
+* 				gate inputs are bypassed (see INPUT_X_LOOP_SKIP). Each
+* 				vector drives only the inputs of its gate and checks only
+* 				the output of its gate, with the expected level taken from
+* 				the IC failure boolean function. Vectors are then reordered
+* 				(see checkerOrderProgram). For the full tier one vector per
+* 				input combination is appended driving every gate at once.
+* 				The golden signature of each tier is the CRC of the
+* 				expected output words of its prefix in execution order,
+* 				computed by the same CRC unit used in signature mode.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		None
+******************************************************************************/
+static void checkerCompileProgram(IC_PARAMETERS_T *IC)
+{
+	uint8_t num_gates = IC->num_outputs;
+	uint8_t num_inputs_gate = IC->num_inputs/IC->num_outputs;
+	uint8_t loop_skip_field = (0xFF << num_inputs_gate);
+	uint8_t gate_start_index = 0;
+	CHECKER_VECTOR_T *vector;
+	uint32_t gate_out;
+	uint8_t gate_num;
+	uint8_t index;
+
+	checkerProgram.ic_designator = IC->ic_designator;
+	checkerProgram.num_vectors = 0;
+	checkerProgram.in_mask = 0U;
+	checkerProgram.out_mask = 0U;
+	checkerProgram.od_mask = 0U;
+
+	for(index = 0; index < IC->num_inputs; index++){
+		if(IC->input_pins[index] <= SOCKET_NUM_PINS) checkerProgram.in_mask |= SocketPinMask[IC->input_pins[index]];
+	}
+	for(index = 0; index < IC->num_outputs; index++){
+		if(IC->output_pins[index] > SOCKET_NUM_PINS) continue;
+		checkerProgram.out_mask |= SocketPinMask[IC->output_pins[index]];
+	}
+	if(IC->output_type == IC_OUTPUT_OPEN_DRAIN) checkerProgram.od_mask = checkerProgram.out_mask;
+	checkerProgram.settle_cycles = CheckerGetSettle(IC);
+
+	for(gate_num = 0; gate_num < num_gates; gate_num++){
+		gate_out = (IC->output_pins[gate_num] <= SOCKET_NUM_PINS) ? SocketPinMask[IC->output_pins[gate_num]] : 0U;
+
+		for(uint8_t gate_input_A = INPUT_A_LOOP_SKIP; gate_input_A < 2; gate_input_A++){
+			for(uint8_t gate_input_B = INPUT_B_LOOP_SKIP; gate_input_B < 2; gate_input_B++){
+				for(uint8_t gate_input_C = INPUT_C_LOOP_SKIP; gate_input_C < 2; gate_input_C++){
+					for(uint8_t gate_input_D = INPUT_D_LOOP_SKIP; gate_input_D < 2; gate_input_D++){
+						if(checkerProgram.num_vectors >= CHECKER_MAX_VECTORS) break;
+						checkerProgram.vector_id[checkerProgram.num_vectors] = checkerProgram.num_vectors;
+						vector = &checkerProgram.vectors[checkerProgram.num_vectors++];
+						vector->drive = 0U;
+						vector->drive_mask = 0U;
+
+						if(INPUT_A_LOOP_SKIP != TRUE) checkerSetClrInputs(vector, IC->input_pins, gate_start_index, 0, gate_input_A);
+						if(INPUT_B_LOOP_SKIP != TRUE) checkerSetClrInputs(vector, IC->input_pins, gate_start_index, 1, gate_input_B);
+						if(INPUT_C_LOOP_SKIP != TRUE) checkerSetClrInputs(vector, IC->input_pins, gate_start_index, 2, gate_input_C);
+						if(INPUT_D_LOOP_SKIP != TRUE) checkerSetClrInputs(vector, IC->input_pins, gate_start_index, 3, gate_input_D);
+
+						vector->care = gate_out;
+						vector->expect = (checkerGateOutput(IC, gate_input_A, gate_input_B, gate_input_C, gate_input_D) == SET) ? gate_out : 0U;
+					}
+				}
+			}
+		}
+		gate_start_index += num_inputs_gate;
+	}
+
+	// Gate loop vectors leave the other gates' inputs as they were, so
+	// bridges between gates need vectors driving every gate at once
+	checkerAddBridgeVectors(IC);
+
+	// Program must be valid for the fault simulation used to order it
+	checkerProgram.valid = TRUE;
+	checkerOrderProgram(IC);
+	checkerProgram.num_standard = checkerProgram.num_vectors;
+
+	// All-gate vectors for the full tier, every gate switched to the same
+	// input combination at once with every output checked
+	for(uint8_t combination = 0; combination < (1U << num_inputs_gate); combination++){
+		if(checkerProgram.num_vectors >= CHECKER_MAX_VECTORS) break;
+		checkerProgram.vector_id[checkerProgram.num_vectors] = checkerProgram.num_vectors;
+		vector = &checkerProgram.vectors[checkerProgram.num_vectors++];
+		vector->drive = 0U;
+		vector->drive_mask = 0U;
+
+		for(gate_num = 0; gate_num < num_gates; gate_num++){
+			for(index = 0; index < num_inputs_gate; index++){
+				checkerSetClrInputs(vector, IC->input_pins, gate_num * num_inputs_gate, index,
+									(combination >> (num_inputs_gate - 1U - index)) & 1U);
+			}
+		}
+		vector->care = checkerProgram.out_mask;
+		vector->expect = CheckerEvaluate(IC, vector->drive);
+	}
+
+	// Golden signature of each tier prefix
+	CRC->CR = CRC_CR_RESET;
+	for(index = 0; index < checkerProgram.num_vectors; index++){
+		CRC->DR = checkerProgram.vectors[index].expect;
+		if((index + 1U) == checkerProgram.num_screen) checkerProgram.signature[CHECKER_TIER_SCREEN] = CRC->DR;
+		if((index + 1U) == checkerProgram.num_standard) checkerProgram.signature[CHECKER_TIER_STANDARD] = CRC->DR;
+	}
+	checkerProgram.signature[CHECKER_TIER_FULL] = CRC->DR;
+
+	FaultDictInvalidate();
+}
+
+/******************************************************************************
+* checkerAddBridgeVectors - Private Function
+*
+* 08/25/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Appends a handful of vectors that drive every gate at once
+* 				(one port-wide write) and check every output in the same
+* 				read, chosen so that every adjacent DIP pin pair used by
+* 				the IC is seen at opposite levels, each way round, with
+* 				the difference observable at an output. Every input
+* 				combination of the IC is scored (into the workspace) and
+* 				vectors are picked greedily, each covering the most pair
+* 				polarities not yet covered, which walks complementary
+* 				patterns across the gates.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		None
+******************************************************************************/
+static void checkerAddBridgeVectors(IC_PARAMETERS_T *IC)
+{
+	uint32_t *coverage = Workspace;
+	uint16_t num_candidates = (uint16_t)1U << IC->num_inputs;
+	uint32_t covered = 0U;
+	CHECKER_VECTOR_T *vector;
+	uint8_t gain;
+	uint8_t best_gain;
+	uint16_t best = 0U;
+
+	if(num_candidates > WORKSPACE_WORDS) return;
+
+	for(uint16_t candidate = 0; candidate < num_candidates; candidate++){
+		coverage[candidate] = checkerBridgeCoverage(IC, checkerInputsToDrive(IC, candidate));
+	}
+
+	for(uint8_t added = 0; added < CHECKER_MAX_BRIDGE_VECTORS; added++){
+		if(checkerProgram.num_vectors >= CHECKER_MAX_VECTORS) break;
+
+		best_gain = 0U;
+		for(uint16_t candidate = 0; candidate < num_candidates; candidate++){
+			gain = checkerCountBits(coverage[candidate] & ~covered);
+			if(gain > best_gain){
+				best_gain = gain;
+				best = candidate;
+			}
+		}
+		if(best_gain == 0U) break;
+		covered |= coverage[best];
+
+		checkerProgram.vector_id[checkerProgram.num_vectors] = checkerProgram.num_vectors;
+		vector = &checkerProgram.vectors[checkerProgram.num_vectors++];
+		vector->drive = checkerInputsToDrive(IC, best);
+		vector->drive_mask = checkerProgram.in_mask;
+		vector->care = checkerProgram.out_mask;
+		vector->expect = CheckerEvaluate(IC, vector->drive);
+	}
+}
+
+/******************************************************************************
+* checkerBridgeCoverage - Private Function
+*
+* 08/25/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the adjacent pin pairs a vector driving every input
+* 				would catch a bridge on. Both pins must be IC inputs or
+* 				outputs and at opposite levels (driven or expected). A
+* 				bridge onto an output shows on that output. A bridge
+* 				between two inputs shows only if an output depends on one
+* 				of them under the other input levels.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint32_t drive - Packed socket word of input levels
+*
+* Return:		Pair polarities covered, bit 2n for pair n with its first
+* 				pin high, bit 2n + 1 with its second pin high
+******************************************************************************/
+static uint32_t checkerBridgeCoverage(IC_PARAMETERS_T *IC, uint32_t drive)
+{
+	uint32_t expect = CheckerEvaluate(IC, drive);
+	uint32_t used = checkerProgram.in_mask | checkerProgram.out_mask;
+	uint32_t levels = (drive & checkerProgram.in_mask) | (expect & checkerProgram.out_mask);
+	uint32_t observable = checkerProgram.out_mask;
+	uint32_t coverage = 0U;
+	uint32_t first;
+	uint32_t second;
+	uint32_t pin_mask;
+
+	for(uint8_t index = 0; index < IC->num_inputs; index++){
+		if(IC->input_pins[index] > SOCKET_NUM_PINS) continue;
+		pin_mask = SocketPinMask[IC->input_pins[index]];
+		if((CheckerEvaluate(IC, drive ^ pin_mask) ^ expect) & checkerProgram.out_mask) observable |= pin_mask;
+	}
+
+	for(uint8_t pair = 0; pair < CHECKER_NUM_ADJACENT; pair++){
+		first = SocketPinMask[checkerAdjacentPins[pair][0]];
+		second = SocketPinMask[checkerAdjacentPins[pair][1]];
+		if(((first & used) == 0U) || ((second & used) == 0U) || (((first | second) & observable) == 0U)) continue;
+
+		if((levels & first) && !(levels & second)) coverage |= (1UL << (2U * pair));
+		else if(!(levels & first) && (levels & second)) coverage |= (1UL << ((2U * pair) + 1U));
+	}
+	return coverage;
+}
+
+/******************************************************************************
+* checkerInputsToDrive - Private Function
+*
+* 08/25/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a combination of every IC input into a packed
+* 				socket word.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint16_t combination - Input levels (bit n = nth input in
+* 				IC->input_pins)
+*
+* Return:		Packed socket word of input levels
+******************************************************************************/
+static uint32_t checkerInputsToDrive(IC_PARAMETERS_T *IC, uint16_t combination)
+{
+	uint32_t drive = 0U;
+
+	for(uint8_t index = 0; index < IC->num_inputs; index++){
+		if((combination & (1U << index)) && (IC->input_pins[index] <= SOCKET_NUM_PINS)) drive |= SocketPinMask[IC->input_pins[index]];
+	}
+	return drive;
+}
+
+/******************************************************************************
+* checkerCountBits - Private Function
+*
+* 08/25/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Counts the set bits of a word.
+*
+* Arguments:    uint32_t word - Word to count
+*
+* Return:		Number of set bits
+******************************************************************************/
+static uint8_t checkerCountBits(uint32_t word)
+{
+	uint8_t count = 0U;
+
+	while(word != 0U){
+		word &= word - 1U;
+		count++;
+	}
+	return count;
+}
+
+/******************************************************************************
+* checkerOrderProgram - Private Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Reorders the compiled vectors so that the most likely
+* 				faults are detected first, minimizing time to reject. Every
+* 				stuck-low and stuck-high fault on a used pin is simulated
+* 				(see FaultDict.c) to find the vectors that detect it. With
+* 				learning enabled each fault is weighted by how often it has
+* 				been logged, and logged bridges are included. Vectors are
+* 				then picked greedily: each position takes the vector that
+* 				detects the greatest weight of faults not yet detected by
+* 				earlier vectors, ties going to gate loop order. The prefix
+* 				that covers every detectable fault is the screen tier.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		None
+******************************************************************************/
+static void checkerOrderProgram(IC_PARAMETERS_T *IC)
+{
+	uint64_t detect[FAULT_DICT_SIZE];
+	uint16_t weight[FAULT_DICT_SIZE];
+	uint64_t covered = 0U;
+	uint32_t used_mask = checkerProgram.in_mask | checkerProgram.out_mask;
+	uint8_t num_faults = 0;
+	uint16_t fault;
+	uint16_t count;
+	uint32_t score;
+	uint32_t best_score;
+	uint8_t best;
+	uint8_t pos;
+	uint8_t index;
+	uint8_t ic_pin;
+	CHECKER_VECTOR_T swap_vector;
+	uint8_t swap_id;
+	uint64_t detectable = 0U;
+
+	for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if((SocketPinMask[ic_pin] & used_mask) == 0U) continue;
+		for(uint16_t type = FAULT_STUCK_LOW; type <= FAULT_STUCK_HIGH; type += FAULT_STUCK_LOW){
+			fault = FAULT_CODE(type, ic_pin, 0U);
+			detect[num_faults] = FaultDictSimulate(IC, fault);
+			weight[num_faults] = CHECKER_PRIOR_WEIGHT;
+			if(checkerLearnEnable == TRUE) weight[num_faults] += FailLogCount(IC->ic_designator, fault);
+			num_faults++;
+		}
+	}
+
+	if(checkerLearnEnable == TRUE){
+		for(ic_pin = 1; (ic_pin < SOCKET_NUM_PINS) && (num_faults < FAULT_DICT_SIZE); ic_pin++){
+			if(((SocketPinMask[ic_pin] & used_mask) == 0U) || ((SocketPinMask[ic_pin + 1] & used_mask) == 0U)) continue;
+			fault = FAULT_CODE(FAULT_BRIDGE, ic_pin, ic_pin + 1U);
+			count = FailLogCount(IC->ic_designator, fault);
+			if(count == 0U) continue;
+			detect[num_faults] = FaultDictSimulate(IC, fault);
+			weight[num_faults++] = count;
+		}
+	}
+
+	for(uint8_t f = 0; f < num_faults; f++){
+		if(detect[f] != 0U) detectable |= ((uint64_t)1U << f);
+	}
+	checkerProgram.num_screen = 0U;
+
+	for(pos = 0; pos < checkerProgram.num_vectors; pos++){
+		best = pos;
+		best_score = 0U;
+		for(index = pos; index < checkerProgram.num_vectors; index++){
+			score = 0U;
+			for(uint8_t f = 0; f < num_faults; f++){
+				if(((covered >> f) & 1U) == 0U && ((detect[f] >> checkerProgram.vector_id[index]) & 1U)) score += weight[f];
+			}
+			if((score > best_score) || ((score == best_score) && (checkerProgram.vector_id[index] < checkerProgram.vector_id[best]))){
+				best = index;
+				best_score = score;
+			}
+		}
+
+		swap_vector = checkerProgram.vectors[pos];
+		checkerProgram.vectors[pos] = checkerProgram.vectors[best];
+		checkerProgram.vectors[best] = swap_vector;
+		swap_id = checkerProgram.vector_id[pos];
+		checkerProgram.vector_id[pos] = checkerProgram.vector_id[best];
+		checkerProgram.vector_id[best] = swap_id;
+
+		for(uint8_t f = 0; f < num_faults; f++){
+			if((detect[f] >> checkerProgram.vector_id[pos]) & 1U) covered |= ((uint64_t)1U << f);
+		}
+
+		// Screen tier ends once every detectable fault is covered
+		if((checkerProgram.num_screen == 0U) && (covered == detectable)) checkerProgram.num_screen = pos + 1U;
+	}
+	if(checkerProgram.num_screen == 0U) checkerProgram.num_screen = checkerProgram.num_vectors;
+}
+
+/******************************************************************************
+* checkerRunProgram - Private Function
+*
+* 08/07/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/10/2019:	Anthony Needles
+* 				Runs a vector prefix. Added timing pass.
+*
+* 08/19/2019:	Anthony Needles
+* 				Mismatching reads put to a majority vote.
+*
+* 08/20/2019:	Anthony Needles
+* 				Drive profile of the IC applied before the first vector.
+*
+* 08/26/2019:	Anthony Needles
+* 				Pull-ups on open-drain outputs.
+*
+* 08/27/2019:	Anthony Needles
+* 				Added retest pass.
+*
+* 08/29/2019:	Anthony Needles
+* 				Pin setup, drive and compare stages profiled.
+*
+* 08/30/2019:	Anthony Needles
+* 				Retest pass applies every input at its level in the
+* 				original run.
+*
+* Description:  Sets every IC input pin as an MCU output (driven low) and
+* 				every IC output pin as an MCU input, with the pull-ups on
+* 				every open-drain output in the same pull register write
+* 				so released outputs read high and a low read shows the
+* 				output sinking the pull-up current. Then applies the
+* 				first num_vectors vectors, each with a single port-wide
+* 				write. For a functional pass each vector is read and
+* 				compared, returning failure immediately. A mismatching
+* 				read in a functional or diagnostic pass is first
+* 				resampled and voted on (see checkerVoteOutput). For a
+* 				signature pass each masked read is fed to the CRC unit
+* 				and only the final CRC is compared. A diagnostic pass
+* 				compares every vector without stopping and records the
+* 				failing vector set. A timing pass polls the
+* 				outputs instead of settling and records the longest time
+* 				taken to reach the expected levels. For an oscillation pass
+* 				each output is sampled for the whole settle window instead.
+* 				A retest pass only applies the vectors in checkerRetestSet
+* 				and leaves the ones still failing in it. Gate loop vectors
+* 				only drive the inputs of their own gate, so the skipped
+* 				vectors are still tracked and each replayed vector writes
+* 				every input at the level it had in a full run. Inputs of
+* 				neighbouring gates then sit as they did when the vector
+* 				failed, which a bridge between gates depends on.
+*
+* Arguments:    CHECKER_PASS_T pass - Type of pass to make
+*
+* 				uint8_t num_vectors - Number of vectors to run
+*
+* Return:		Test pass or test failure
+******************************************************************************/
+static uint8_t checkerRunProgram(CHECKER_PASS_T pass, uint8_t num_vectors)
+{
+	const CHECKER_VECTOR_T *vector;
+	uint32_t test_output;
+	uint32_t golden;
+	uint32_t levels = 0U;
+	uint32_t level_mask;
+	uint16_t start;
+	uint16_t elapsed;
+	uint8_t index;
+
+	const CHECKER_DRIVE_T *drive = &checkerDrive[checkerProgram.ic_designator % CHECKER_NUM_DESIGNATORS];
+
+	PROFILE_MARK();
+	SOCKET_WRITE(0U, checkerProgram.in_mask);
+	SocketSetOutputs(checkerProgram.in_mask);
+	SocketSetInputs(checkerProgram.out_mask);
+	SocketSetSpeed(checkerProgram.in_mask, drive->speed);
+	SocketSetSpeed(checkerProgram.in_mask & checkerPinsToMask(drive->slow_pins), SOCKET_SPEED_LOW);
+	SocketSetPull(checkerProgram.out_mask & ~checkerProgram.od_mask, drive->output_pull);
+	SocketSetPull(checkerProgram.od_mask, SOCKET_PULL_UP);
+	PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_SETUP);
+
+	if(pass == CHECKER_PASS_SIGNATURE) CRC->CR = CRC_CR_RESET;
+
+	for(index = 0; index < num_vectors; index++){
+		// Over-current shutdown floated the socket, stop driving it
+		if(OcTripped() == TRUE) return FAILED;
+
+		vector = &checkerProgram.vectors[index];
+		level_mask = vector->drive_mask;
+		if(pass == CHECKER_PASS_RETEST){
+			levels = (levels & ~vector->drive_mask) | (vector->drive & vector->drive_mask);
+			if(((checkerRetestSet >> index) & 1U) == 0U) continue;
+			level_mask = checkerProgram.in_mask;
+		} else {
+			levels = vector->drive;
+		}
+
+		PROFILE_MARK();
+		SOCKET_WRITE(levels, level_mask);
+		PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_DRIVE);
+
+		switch(pass){
+		case CHECKER_PASS_SIGNATURE:
+			CRC->DR = checkerReadICOutput() & vector->care;
+			PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_COMPARE);
+			break;
+
+		case CHECKER_PASS_OSCILLATION:
+			OscSampleOutputs(vector->care, checkerProgram.settle_cycles);
+			break;
+
+		case CHECKER_PASS_TIMING:
+			start = TIMESTAMP_NOW();
+			do{
+				elapsed = (uint16_t)(TIMESTAMP_NOW() - start);
+			} while(((SOCKET_READ() ^ vector->expect) & vector->care) && (elapsed < CHECKER_TIMING_LIMIT));
+			if(elapsed > checkerResult.max_delay_cycles) checkerResult.max_delay_cycles = elapsed;
+			break;
+
+		case CHECKER_PASS_DIAGNOSTIC:
+			test_output = checkerReadICOutput();
+			if((test_output ^ vector->expect) & vector->care) test_output = checkerVoteOutput(test_output, vector);
+			PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_COMPARE);
+			if((test_output ^ vector->expect) & vector->care){
+				checkerResult.fail_set |= ((uint64_t)1U << index);
+			}
+			break;
+
+		case CHECKER_PASS_RETEST:
+			test_output = checkerReadICOutput();
+			if((test_output ^ vector->expect) & vector->care) test_output = checkerVoteOutput(test_output, vector);
+			PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_COMPARE);
+			if(((test_output ^ vector->expect) & vector->care) == 0U){
+				checkerRetestSet &= ~((uint64_t)1U << index);
+			}
+			break;
+
+		default:
+			test_output = checkerReadICOutput();
+			if((test_output ^ vector->expect) & vector->care) test_output = checkerVoteOutput(test_output, vector);
+			PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_COMPARE);
+			if((test_output ^ vector->expect) & vector->care){
+				checkerResult.fail_vector = index;
+				return FAILED;
+			}
+			break;
+		}
+	}
+
+	if(pass == CHECKER_PASS_SIGNATURE){
+		if(num_vectors == checkerProgram.num_screen) golden = checkerProgram.signature[CHECKER_TIER_SCREEN];
+		else if(num_vectors == checkerProgram.num_standard) golden = checkerProgram.signature[CHECKER_TIER_STANDARD];
+		else golden = checkerProgram.signature[CHECKER_TIER_FULL];
+
+		checkerResult.signature = CRC->DR;
+		if(checkerResult.signature != golden) return FAILED;
+	}
+	return PASSED;
+}
+
+/******************************************************************************
+* checkerTierVectors - Private Function
+*
+* 08/10/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the length of the vector prefix run by a tier of
+* 				the compiled program.
+*
+* Arguments:    CHECKER_TIER_T tier - Test tier
+*
+* Return:		Number of vectors
+******************************************************************************/
+static uint8_t checkerTierVectors(CHECKER_TIER_T tier)
+{
+	switch(tier){
+	case CHECKER_TIER_SCREEN:
+		return checkerProgram.num_screen;
+
+	case CHECKER_TIER_STANDARD:
+		return checkerProgram.num_standard;
+
+	default:
+		return checkerProgram.num_vectors;
+	}
+}
+
+/******************************************************************************
+* checkerMeasureMargin - Private Function
+*
+* 08/10/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Binary searches the shortest settle time the IC still
+* 				passes every characterize vector with, to within
+* 				CHECKER_MARGIN_RESOLUTION. The compiled settle time is
+* 				restored afterwards. Settle margin is the compiled settle
+* 				time less the result.
+*
+* Arguments:    None
+*
+* Return:		Shortest passing settle time in SYSCLK cycles
+******************************************************************************/
+static uint16_t checkerMeasureMargin(void)
+{
+	uint16_t settle_cycles = checkerProgram.settle_cycles;
+	uint8_t vote_samples = checkerVoteSamples;
+	uint16_t low = 0U;
+	uint16_t high = settle_cycles;
+
+	// Resampling would give a late read extra settle time
+	checkerVoteSamples = 0U;
+
+	while((uint16_t)(high - low) > CHECKER_MARGIN_RESOLUTION){
+		checkerProgram.settle_cycles = (low + high) >> 1;
+		if(checkerRunProgram(CHECKER_PASS_FUNCTIONAL, checkerProgram.num_vectors) == PASSED) high = checkerProgram.settle_cycles;
+		else low = checkerProgram.settle_cycles;
+	}
+
+	checkerProgram.settle_cycles = settle_cycles;
+	checkerVoteSamples = vote_samples;
+	checkerResult.fail_vector = CHECKER_NO_VECTOR;
+	return high;
+}
+
+/******************************************************************************
+* checkerKeepFailure - Private Function
+*
+* 08/27/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Keeps the failing vectors of a rejected IC for retest, by
+* 				gate loop order index. The full failing set is kept when
+* 				diagnosis collected it, otherwise the first failing
+* 				vector. ICs rejected without a failing vector (IDDQ,
+* 				high-Z or oscillation) have nothing to retest.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		None
+******************************************************************************/
+static void checkerKeepFailure(IC_PARAMETERS_T *IC)
+{
+	uint64_t fail_set = checkerResult.fail_set;
+
+	if((fail_set == 0U) && (checkerResult.fail_vector != CHECKER_NO_VECTOR)){
+		fail_set = (uint64_t)1U << checkerResult.fail_vector;
+	}
+	if(fail_set == 0U) return;
+
+	checkerFailure.IC = *IC;
+	checkerFailure.vector_ids = 0U;
+	for(uint8_t index = 0; index < checkerProgram.num_vectors; index++){
+		if((fail_set >> index) & 1U) checkerFailure.vector_ids |= ((uint64_t)1U << checkerProgram.vector_id[index]);
+	}
+	checkerFailure.fault = checkerResult.fault;
+	checkerFailure.fail_vector = checkerResult.fail_vector;
+	checkerFailure.attempts = 0U;
+	checkerFailure.valid = TRUE;
+}
+
+/******************************************************************************
+* checkerSetClrInputs - Private Function
+*
+* 12/09/2018:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/04/2019:	Anthony Needles
+* 				Ported function for use with LICC v3.0.
+*
+* 08/05/2019:	Anthony Needles
+* 				Replaced per-pin switch with socket pin map lookup.
+*
+* 08/07/2019:	Anthony Needles
+* 				Sets/clears the pin in a vector being compiled instead of
+* 				writing the GPIO directly.
+*
+* Description:  Handed input pin number array for given IC, whether to
+* 				set or clear, the index the current gate input group is
+* 				located in the pin number array, and which number input
+* 				of the gate is specified. This function derives
+* 				which specific IC pin is desired to set/clear based on
+* 				passed specifications and adds it to the vector.
+*
+* Arguments:    CHECKER_VECTOR_T *vector - Vector being compiled
+*
+* 				uint8_t *input_pins - Input IC pin number array (in
+* 				order) for tested IC.
+*
+* 				uint8_t gate_start - Index of pin number array that
+* 				current input group starts.
+*
+* 				uint8_t input_offset - Offset of specific pin in input
+* 				group that is desired to be set/cleared.
+*
+* 				uint8_t input_value - Desired value to give to input
+* 				pin (1 for set, 0 for clear).
+*
+* Return:		None
+******************************************************************************/
+void checkerSetClrInputs(CHECKER_VECTOR_T *vector, uint8_t *input_pins, uint8_t gate_start, uint8_t input_offset, uint8_t input_state)
+{
+	uint8_t ic_pin = input_pins[gate_start + input_offset];
+	uint32_t pin_mask;
+
+	if(ic_pin > SOCKET_NUM_PINS) return;
+	pin_mask = SocketPinMask[ic_pin];
+
+	vector->drive_mask |= pin_mask;
+	(input_state == SET) ? (vector->drive |= pin_mask) : (vector->drive &= ~pin_mask);
+}
+
+/******************************************************************************
+* checkerReadICOutput - Private Function
+*
+* 12/09/2018:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/04/2019:	Anthony Needles
+* 				Ported function for use with LICC v3.0.
+*
+* 08/05/2019:	Anthony Needles
+* 				Fixed incorrect read shifts. Replaced per-pin switch
+* 				with socket pin map lookup.
+*
+* 08/07/2019:	Anthony Needles
+* 				Reads every socket pin at once. Output pin modes are set
+* 				once per program run instead of per read.
+*
+* 08/23/2019:	Anthony Needles
+* 				Starts the IDDQ sample when screening, timed to end
+* 				with the settle window.
+*
+* 08/29/2019:	Anthony Needles
+* 				Settle and read stages profiled.
+*
+* Description:  TIM17 is enabled and has update interrupt flag polled in
+* 				order to generate a delay of only a few clock cycles
+* 				(program settle time). This allows any gate output changes
+* 				time to propagate so that readings are correct. Both
+* 				ports are then read and returned as a packed socket word.
+*
+* Arguments:    None
+*
+* Return:		Packed socket word read from GPIO inputs
+******************************************************************************/
+uint32_t checkerReadICOutput(void)
+{
+	uint32_t test_output;
+
+	PROFILE_MARK();
+	if(checkerIddqActive == TRUE){
+		if(checkerProgram.settle_cycles > IDDQ_LEAD_CYCLES){
+			checkerSettle(checkerProgram.settle_cycles - IDDQ_LEAD_CYCLES);
+		}
+		IDDQ_SAMPLE();
+		checkerSettle(IDDQ_LEAD_CYCLES);
+	} else {
+		checkerSettle(checkerProgram.settle_cycles);
+	}
+	PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_SETTLE);
+
+	test_output = SOCKET_READ();
+	PROFILE_STAGE(checkerProgram.ic_designator, PROFILE_READ);
+	return test_output;
+}
+
+/******************************************************************************
+* checkerVoteOutput - Private Function
+*
+* 08/19/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Called when the first read of a vector mismatches. Takes
+* 				the extra samples CHECKER_VOTE_SPACING cycles apart and
+* 				gives each mismatching output the level seen in most of
+* 				the samples, the first included. Counts the vote, and
+* 				whether it overturned the first sample.
+*
+* Arguments:    uint32_t first - Packed socket word of first read
+*
+* 				const CHECKER_VECTOR_T *vector - Vector being checked
+*
+* Return:		Packed socket word of voted output levels
+******************************************************************************/
+static uint32_t checkerVoteOutput(uint32_t first, const CHECKER_VECTOR_T *vector)
+{
+	uint32_t mismatch = (first ^ vector->expect) & vector->care;
+	uint8_t agree[SOCKET_NUM_PINS + 1] = {0};
+	uint32_t voted = first;
+	uint32_t sample;
+	uint16_t start;
+
+	if(checkerVoteSamples == 0U) return first;
+	checkerVoteStats.votes++;
+
+	for(uint8_t count = 0; count < checkerVoteSamples; count++){
+		start = TIMESTAMP_NOW();
+		while((uint16_t)(TIMESTAMP_NOW() - start) < CHECKER_VOTE_SPACING){}
+		sample = SOCKET_READ();
+
+		for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+			if((mismatch & SocketPinMask[ic_pin]) && (((sample ^ vector->expect) & SocketPinMask[ic_pin]) == 0U)) agree[ic_pin]++;
+		}
+	}
+
+	// First sample disagreed, so expected level needs a strict majority of
+	// the extra samples plus one
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if((mismatch & SocketPinMask[ic_pin]) && (agree[ic_pin] > (checkerVoteSamples / 2U))) voted ^= SocketPinMask[ic_pin];
+	}
+
+	if(((voted ^ vector->expect) & vector->care) == 0U) checkerVoteStats.overturned++;
+	return voted;
+}
+
+/******************************************************************************
+* checkerPinsToMask - Private Function
+*
+* 08/20/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a bit field of IC pins into a packed socket mask.
+*
+* Arguments:    uint16_t ic_pins - Bit field of IC pins (bit n = IC pin n)
+*
+* Return:		Packed socket pin mask
+******************************************************************************/
+static uint32_t checkerPinsToMask(uint16_t ic_pins)
+{
+	uint32_t mask = 0U;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(ic_pins & (1U << ic_pin)) mask |= SocketPinMask[ic_pin];
+	}
+	return mask;
+}
+
+/******************************************************************************
+* checkerOpenOutputs - Private Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/26/2019:	Anthony Needles
+* 				Released open-drain outputs skipped.
+*
+* Description:  Reads the IC outputs with the MCU pull-ups and then the
+* 				pull-downs enabled, with the last vector still applied. A
+* 				driven output ignores the pulls, an open output follows
+* 				them. Open-drain outputs expected high are released and
+* 				follow the pulls, so only the low ones are checked.
+*
+* Arguments:    uint32_t expect - Expected levels of the last vector
+*
+* Return:		Bit field of open output IC pins (bit n = IC pin n)
+******************************************************************************/
+static uint16_t checkerOpenOutputs(uint32_t expect)
+{
+	uint32_t checked = checkerProgram.out_mask & ~(checkerProgram.od_mask & expect);
+	uint32_t pulled_up;
+	uint32_t pulled_down;
+	uint16_t open_pins = 0U;
+
+	SocketSetPull(checkerProgram.out_mask, SOCKET_PULL_UP);
+	pulled_up = checkerReadICOutput();
+	SocketSetPull(checkerProgram.out_mask, SOCKET_PULL_DOWN);
+	pulled_down = checkerReadICOutput();
+	SocketSetPull(checkerProgram.out_mask, SOCKET_PULL_NONE);
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if((pulled_up & ~pulled_down) & checked & SocketPinMask[ic_pin]) open_pins |= (1U << ic_pin);
+	}
+	return open_pins;
+}
+
+/******************************************************************************
+* checkerSettle - Private Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function (split from
+* 				checkerReadICOutput).
+*
+* 08/06/2019:	Anthony Needles
+* 				Delay length passed in to allow per-pin offsets.
+*
+* Description:  Runs TIM17 for a single pulse of the given length and
+* 				polls the update flag, giving gate outputs time to
+* 				propagate. The update flag is cleared first, otherwise
+* 				every delay after the first would return immediately.
+*
+* Arguments:    uint16_t cycles - Delay length in SYSCLK cycles
+*
+* Return:		None
+******************************************************************************/
+static void checkerSettle(uint16_t cycles)
+{
+	TIM17->ARR = cycles;
+	TIM17->SR = ~TIM_SR_UIF;
+	TIM17->CR1 |= TIM_CR1_CEN;
+	while((TIM17->SR & TIM_SR_UIF_Msk) == 0){}
+}
+
+/******************************************************************************
+* checkerGateOutput - Private Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives the expected output level of one gate for a set of
+* 				gate input levels. User ICs look the level up in their
+* 				truth table, built-in ICs take it from their failure
+* 				function (a low output passes only if low is expected).
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint8_t in_A - in_D - Gate input levels (unused inputs set)
+*
+* Return:		SET if the output is expected high, otherwise 0
+******************************************************************************/
+static uint8_t checkerGateOutput(const IC_PARAMETERS_T *IC, uint8_t in_A, uint8_t in_B, uint8_t in_C, uint8_t in_D)
+{
+	uint8_t index = in_A | (in_B << 1) | (in_C << 2) | (in_D << 3);
+
+	if(IC->ic_designator >= IC_USER) return (IC->truth_table >> index) & 1U;
+	return (checkerFailTest(IC->ic_designator, 0, in_A, in_B, in_C, in_D) == PASSED) ? 0U : SET;
 }
 
 /********************************************************************
@@ -18,12 +18,78 @@
 * 	Completed test loop generic to IC, only needing IC parameters. Defines
 * 	for loop skipping created.
 *
+* 	08/05/2019:
+* 	IC parameter constants moved to Checker.c (declared extern here). Added
+* 	test result record and optional output oscillation post-pass.
+*
+* 	08/06/2019:
+* 	Added per-pin settle time offsets from fixture calibration.
+*
+* 	08/07/2019:
+* 	Added response signature mode. Result record holds failing vector.
+*
+* 	08/08/2019:
+* 	Compiled vector program made public for fault simulation. Result record
+* 	holds failing vector set and dictionary fault.
+*
+* 	08/09/2019:
+* 	Vector programs ordered by fault detection likelihood.
+*
+* 	08/10/2019:
+* 	Added test tiers with vector count and duration estimates.
+*
+* 	08/11/2019:
+* 	Added IC class and 74HC164 shift register. Up to 8 outputs per IC.
+*
+* 	08/12/2019:
+* 	Added 74HC393 binary counter.
+*
+* 	08/17/2019:
+* 	Added user ICs uploaded at runtime, defined by a gate truth table.
+*
+* 	08/19/2019:
+* 	Added majority vote of mismatching output reads.
+*
+* 	08/20/2019:
+* 	Added per-IC drive profiles and drive speed measurement.
+*
+* 	08/22/2019:
+* 	Added logic family classification to the result record.
+*
+* 	08/23/2019:
+* 	Added IDDQ screening with worst current vector in the result record.
+*
+* 	08/24/2019:
+* 	Result record flags tests abandoned on an over-current shutdown.
+*
+* 	08/25/2019:
+* 	Added bridging vectors between adjacent DIP pins to the standard tier.
+*
+* 	08/26/2019:
+* 	Added output type to the IC parameters for open-drain ICs.
+*
+* 	08/27/2019:
+* 	Added retest of the failing vectors of a rejected IC, with a log of
+* 	retest outcomes.
+*
+* 	08/28/2019:
+* 	Result record holds die temperature and VDDA at test time.
+*
+* 	08/30/2019:
+* 	Retested vectors applied with every input as in the original run.
+* 	Settle time of an IC made public for the shift register test.
+*
+* 	08/31/2019:
+* 	Added drive profile read access.
+*
 * 	Created on: 12/09/2018
 * 	Author: Anthony Needles
 ******************************************************************************/
 #ifndef CHECKER_H_
 #define CHECKER_H_
 
+#include "Socket.h"
+
 /********************************************************************
 * Public Definitions
 ********************************************************************/
@@ -33,6 +99,17 @@
 
 #define PASSED 1U
 
+#define CHECKER_NO_VECTOR 0xFFU
+// Result record failing vector index when no vector failed
+
+#define CHECKER_MAX_BRIDGE_VECTORS 8U
+// Most vectors added to cover the adjacent DIP pin pairs (2-4 in practice)
+
+#define CHECKER_MAX_VECTORS (48U + CHECKER_MAX_BRIDGE_VECTORS)
+// Largest compiled vector program (2 gates x 16 vectors for 4 input gates
+// plus 16 all-gate vectors is the largest built-in program, plus bridging
+// vectors)
+
 #define IC_74HC00_FAIL (in_A & in_B) != !out
 #define IC_74HC02_FAIL (in_A | in_B) != !out
 #define IC_74HC04_FAIL in_A != !out
@@ -51,56 +128,209 @@ typedef enum {IC_74HC00,
 			  IC_74HC10,
 			  IC_74HC20,
 			  IC_74HC27,
-			  IC_74HC86
+			  IC_74HC86,
+			  IC_74HC164,
+			  IC_74HC393,
+			  IC_USER
 } IC_DESIGNATOR_T;
-// Unique identifier for each IC enumeration
+// Unique identifier for each IC enumeration. Uploaded ICs are numbered from
+// IC_USER by the slot they are stored in (see UserIc.h).
+
+typedef enum {IC_CLASS_GATE,
+			  IC_CLASS_SHIFT_REGISTER,
+			  IC_CLASS_COUNTER
+} IC_CLASS_T;
+// How an IC is tested. Gate ICs are tested through their boolean failure
+// function, gate by gate. Shift registers are clocked through a shift
+// pattern (see ShiftReg.h for pin roles). Counters are clocked through their
+// count sequence in hardware (see Counter.h for pin roles).
+
+typedef enum {IC_OUTPUT_PUSH_PULL,
+			  IC_OUTPUT_OPEN_DRAIN
+} IC_OUTPUT_T;
+// How the IC outputs drive. Open-drain outputs (74HC03 style) only sink, a
+// released output floats and is given its high level by the MCU pull-up.
 
 typedef struct {
 	IC_DESIGNATOR_T ic_designator;
 	uint8_t num_inputs;
 	uint8_t num_outputs;
 	uint8_t input_pins[9];
-	uint8_t output_pins[6];
+	uint8_t output_pins[8];
+	IC_CLASS_T ic_class;
+	uint16_t truth_table;
+	uint8_t output_type;
 } IC_PARAMETERS_T;
 // Structure to hold various parameters for a given IC necessary
-// for testing
+// for testing. User ICs give the output of every gate in truth_table, bit n
+// for the inputs n (bit 0 = first input of the gate), with unused inputs
+// set. Built-in ICs use the failure functions and leave it 0. Output type
+// is an IC_OUTPUT_T.
 
-/******************************************************************************
-* Public Constants
-******************************************************************************/
-const IC_PARAMETERS_T IC_74HC00_PARAM = {IC_74HC00, 8, 4,
-										{1, 2, 4, 5, 9, 10, 12, 13},
-										{3, 6, 8, 11} };
+#define CHECKER_NUM_DESIGNATORS 16U
+// Built-in and user IC designators (4 bits, see FailLog.h)
+
+typedef struct {
+	SOCKET_SPEED_T speed;
+	SOCKET_PULL_T output_pull;
+	uint16_t slow_pins;
+	uint16_t settle_cycles;
+} CHECKER_DRIVE_T;
+// Drive profile of an IC: output speed of the MCU pins driving the IC
+// inputs, pull applied to the IC outputs, IC input pins kept at low speed
+// whatever the profile speed (bit n = IC pin n, for pins that ring), and
+// base settle time replacing CYCLES_DELAY (0 keeps CYCLES_DELAY). All zero
+// (reset GPIO settings) by default.
+
+#define CHECKER_NUM_SPEEDS 3U
+// Output speeds tried by CheckerMeasureDrive (low, medium, high)
+
+#define CHECKER_NO_DRIVE 0xFFU
+// CheckerMeasureDrive result when no speed gave clean reads
+
+typedef struct {
+	SOCKET_SPEED_T speed;
+	uint8_t passed;
+	uint16_t min_settle_cycles;
+	uint16_t votes;
+	uint16_t overturned;
+} CHECKER_DRIVE_RESULT_T;
+// Drive speed measurement of one speed: whether the IC passed every vector
+// at nominal settle, the shortest settle time it passes with (SYSCLK
+// cycles), and how many reads were misread and put to a majority vote
+
+typedef enum {CHECKER_TIER_SCREEN,
+			  CHECKER_TIER_STANDARD,
+			  CHECKER_TIER_FULL,
+			  CHECKER_TIER_CHARACTERIZE
+} CHECKER_TIER_T;
+// Test level. Screen runs the shortest vector prefix detecting every
+// stuck-at fault, standard runs every input combination of every gate, full
+// adds all-gate vectors (every gate switching together) and a high-Z check of
+// the outputs, characterize adds propagation delay and settle margin.
+
+typedef struct {
+	uint8_t num_vectors;
+	uint32_t duration_us;
+} CHECKER_TIER_INFO_T;
+// Vector count and estimated duration of a test tier for a given IC
+
+typedef struct {
+	IC_DESIGNATOR_T ic_designator;
+	uint8_t passed;
+	int16_t temp_dc;
+	uint16_t vdda_mv;
+	uint8_t fail_vector;
+	uint8_t sig_mismatch;
+	uint16_t osc_pins;
+	uint32_t signature;
+	uint64_t fail_set;
+	uint16_t fault;
+	uint8_t fault_candidates;
+	CHECKER_TIER_T tier;
+	uint8_t vectors_run;
+	uint16_t hiz_pins;
+	uint16_t max_delay_cycles;
+	uint16_t min_settle_cycles;
+	uint8_t family;
+	uint16_t iddq_ua;
+	uint8_t iddq_vector;
+	uint8_t overcurrent;
+} CHECKER_RESULT_T;
+// Record of the most recent CheckerTestIC run: IC tested, pass/fail, die
+// temperature (0.1C) and VDDA (mV) at test time, index of first failing
+// vector, whether signature mode saw a mismatch, bit field
+// of IC pins flagged by the oscillation post-pass (bit n = IC pin n), the
+// last measured response signature, the full failing vector set of a
+// rejected IC (bit n = vector n), and the most likely defect from the fault
+// dictionary along with how many dictionary entries matched equally. Also
+// the tier run and its vector count, outputs failing the high-Z check (bit
+// n = IC pin n), and for characterize the slowest output propagation delay
+// and the shortest settle time the IC passes with (SYSCLK cycles), and the
+// logic family of a passing IC when classified (FAMILY_T, see Family.h).
+// With IDDQ screening, the highest supply current sampled (uA) and the
+// vector drawing it. Whether the test was abandoned on an over-current
+// shutdown (see OverCurrent.h).
 
-const IC_PARAMETERS_T IC_74HC02_PARAM = {IC_74HC02, 8, 4,
-										{2, 3, 5, 6, 8, 9, 11, 12},
-										{1, 4, 10, 13} };
+typedef struct {
+	uint32_t votes;
+	uint32_t overturned;
+} CHECKER_VOTE_STATS_T;
+// Mismatching reads put to a majority vote, and votes in which the
+// majority agreed with the expected levels (first sample was a misread)
 
-const IC_PARAMETERS_T IC_74HC04_PARAM = {IC_74HC04, 6, 6,
-										{1, 3, 5, 9, 11, 13},
-										{2, 4, 6, 8, 10, 12} };
+#define CHECKER_VOTE_DEFAULT 4U
+#define CHECKER_VOTE_MAX 8U
+// Extra samples taken when a read mismatches, giving an odd number of
+// samples to vote over
 
-const IC_PARAMETERS_T IC_74HC08_PARAM = {IC_74HC08, 8, 4,
-										{1, 2, 4, 5, 9, 10, 12, 13},
-										{3, 6, 8, 11} };
+typedef struct {
+	uint32_t drive;
+	uint32_t drive_mask;
+	uint32_t expect;
+	uint32_t care;
+} CHECKER_VECTOR_T;
+// Single test vector, all fields are packed socket words (see Socket.h):
+// input levels to drive, input pins driven, expected output levels, and
+// output pins checked
 
-const IC_PARAMETERS_T IC_74HC10_PARAM = {IC_74HC10, 9, 3,
-										{1, 2, 13, 3, 4, 5, 9, 10, 11},
-										{12, 6, 8} };
+typedef struct {
+	IC_DESIGNATOR_T ic_designator;
+	uint8_t valid;
+	uint8_t num_vectors;
+	uint8_t num_screen;
+	uint8_t num_standard;
+	uint16_t settle_cycles;
+	uint32_t in_mask;
+	uint32_t out_mask;
+	uint32_t od_mask;
+	uint32_t signature[CHECKER_TIER_FULL + 1];
+	CHECKER_VECTOR_T vectors[CHECKER_MAX_VECTORS];
+	uint8_t vector_id[CHECKER_MAX_VECTORS];
+} CHECKER_PROGRAM_T;
+// Compiled test program for one IC: total, screen and standard vector
+// counts (each tier runs a prefix of the program), all IC input and output
+// pins, open-drain output pins, settle time including calibration offsets
+// of the output pins, golden CRC response signature of each tier prefix,
+// the vectors in execution order, and the gate loop order index of each
+// vector
 
-const IC_PARAMETERS_T IC_74HC20_PARAM = {IC_74HC20, 8, 2,
-										{1, 2, 4, 5, 9, 10, 12, 13},
-										{6, 8} };
+#define CHECKER_RETEST_LOG_SIZE 8U
+// Retest outcomes kept, oldest overwritten first
 
-const IC_PARAMETERS_T IC_74HC27_PARAM = {IC_74HC27, 9, 3,
-										{1, 2, 13, 3, 4, 5, 9, 10, 11},
-										{12, 6, 8} };
+#define CHECKER_NO_RETEST 0xFFU
+// CheckerRetestFailures result when there is no failure to retest
 
-const IC_PARAMETERS_T IC_74HC86_PARAM = {IC_74HC86, 8, 4,
-										{1, 2, 4, 5, 9, 10, 12, 13},
-										{3, 6, 8, 11} };
+typedef struct {
+	IC_DESIGNATOR_T ic_designator;
+	uint16_t fault;
+	uint8_t fail_vector;
+	uint8_t attempt;
+	uint16_t extra_settle_cycles;
+	uint8_t num_retested;
+	uint8_t num_failing;
+	uint8_t passed;
+} CHECKER_RETEST_T;
+// Outcome of one retest: the original failure (IC, diagnosed fault and first
+// failing vector), which retest of that failure it was (from 1), settle time
+// added, vectors replayed, vectors still failing, and whether all of them
+// passed (a contact problem rather than a bad IC)
+
+/******************************************************************************
+* Public Constants
+******************************************************************************/
+extern const IC_PARAMETERS_T IC_74HC00_PARAM;
+extern const IC_PARAMETERS_T IC_74HC02_PARAM;
+extern const IC_PARAMETERS_T IC_74HC04_PARAM;
+extern const IC_PARAMETERS_T IC_74HC08_PARAM;
+extern const IC_PARAMETERS_T IC_74HC10_PARAM;
+extern const IC_PARAMETERS_T IC_74HC20_PARAM;
+extern const IC_PARAMETERS_T IC_74HC27_PARAM;
+extern const IC_PARAMETERS_T IC_74HC86_PARAM;
+extern const IC_PARAMETERS_T IC_74HC164_PARAM;
+extern const IC_PARAMETERS_T IC_74HC393_PARAM;
 // 74HCXX Parameters: IC Designator, # of inputs, # of outputs, list of input
-// pins, and list of output pins
+// pins, list of output pins, IC class, truth table (user ICs) and output type
 // Note: Input lists shall have all input pin(s) for a certain gate grouped
 // together, and their corresponding output pin shall be placed accordingly in
 // the output list
@@ -108,11 +338,12 @@ const IC_PARAMETERS_T IC_74HC86_PARAM = {IC_74HC86, 8, 4,
 /********************************************************************
 * CheckerInit - Initializes required checker peripherals
 *
-* Description:  Enables clocks for GPIO ports A, B, and C. Enables
-* 				TIM22 with count value of desired delays measured
+* Description:  Enables clocks for GPIO ports A and B. Enables
+* 				TIM17 with count value of desired delays measured
 * 				in cycles. This timer will be used for delaying
 * 				small amounts to ensure any output gate change has
 * 				time to propagate the system. One pulse mode enabled.
+* 				AdcInit must have been called (over-current shutdown).
 *
 * Return value:	None
 *
@@ -140,4 +371,317 @@ void CheckerInit(void);
 ********************************************************************/
 uint8_t CheckerTestIC(IC_PARAMETERS_T);
 
+/********************************************************************
+* CheckerSetOscillationCheck - Enables oscillation post-pass
+*
+* Description:  When enabled, ICs that pass the functional test have
+* 				every gate input combination applied again while each
+* 				output is sampled throughout the settle window (see
+* 				Oscillation.c). Any oscillating output fails the IC.
+* 				Rejected ICs never run the post-pass.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+********************************************************************/
+void CheckerSetOscillationCheck(uint8_t);
+
+/********************************************************************
+* CheckerSetFamilyCheck - Enables logic family classification
+*
+* Description:  When enabled, gate ICs that pass have their logic family
+* 				(HC, HCT or LS) classified from input thresholds and output
+* 				levels (see Family.c), ~2ms per IC. The family is reported
+* 				in the result record and does not affect pass/fail.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+********************************************************************/
+void CheckerSetFamilyCheck(uint8_t);
+
+/********************************************************************
+* CheckerSetIddqCheck - Enables supply current (IDDQ) screening
+*
+* Description:  When enabled, the supply current of every gate IC vector
+* 				is sampled at the end of its settle window during the
+* 				first pass over the program (see Iddq.c). An IC drawing
+* 				more than its limit on any vector fails.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+********************************************************************/
+void CheckerSetIddqCheck(uint8_t);
+
+/********************************************************************
+* CheckerSetSignatureMode - Enables response signature compaction
+*
+* Description:  When enabled, CheckerTestIC feeds the packed output word
+* 				of every vector into the hardware CRC unit instead of
+* 				comparing each vector, then makes a single compare against
+* 				the golden signature of the IC. A mismatch reruns the
+* 				per-vector compare to find the failing vector.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+********************************************************************/
+void CheckerSetSignatureMode(uint8_t);
+
+/********************************************************************
+* CheckerSetDiagnosis - Enables fault diagnosis of rejected ICs
+*
+* Description:  When enabled (default), a rejected IC has every vector
+* 				rerun to collect its failing vector set, and the fault
+* 				dictionary lookup result is placed in the result record.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+********************************************************************/
+void CheckerSetDiagnosis(uint8_t);
+
+/********************************************************************
+* CheckerSetLearning - Enables vector order learning from rejects
+*
+* Description:  When enabled, the fault diagnosed on every rejected IC
+* 				is logged to flash and the vector order of each IC is
+* 				weighted by how often each fault has been seen. Requires
+* 				diagnosis to be enabled. Disabled by default, vectors are
+* 				then ordered by stuck-at coverage alone.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t enable - 1 to enable, 0 to disable
+********************************************************************/
+void CheckerSetLearning(uint8_t);
+
+/********************************************************************
+* CheckerSetTier - Selects test level
+*
+* Description:  Selects the test tier run by CheckerTestIC (see
+* 				CHECKER_TIER_T). Standard by default.
+*
+* Return value:	None
+*
+* Arguments:    CHECKER_TIER_T tier - Test tier
+********************************************************************/
+void CheckerSetTier(CHECKER_TIER_T);
+
+/********************************************************************
+* CheckerGetTierInfo - Returns vector count and duration of a tier
+*
+* Description:  Compiles the IC if required and fills in the number of
+* 				vectors the tier runs on it and an estimate of how long
+* 				a passing IC takes to test at that tier.
+*
+* Return value:	None
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				CHECKER_TIER_T tier - Test tier
+*
+* 				CHECKER_TIER_INFO_T *info - Filled in with tier info
+********************************************************************/
+void CheckerGetTierInfo(IC_PARAMETERS_T*, CHECKER_TIER_T, CHECKER_TIER_INFO_T*);
+
+/********************************************************************
+* CheckerGetProgram - Returns compiled vector program of an IC
+*
+* Description:  Gives read access to the compiled vector program of the
+* 				given IC, compiling it first if a different IC (or none)
+* 				is currently compiled.
+*
+* Return value:	Pointer to compiled program
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+********************************************************************/
+const CHECKER_PROGRAM_T *CheckerGetProgram(IC_PARAMETERS_T*);
+
+/********************************************************************
+* CheckerEvaluate - Computes expected IC outputs for given inputs
+*
+* Description:  Computes the output levels of every gate of the IC for a
+* 				given set of input levels, using the IC failure boolean
+* 				functions. Unused gate inputs are treated as set, the same
+* 				as the gate loops.
+*
+* Return value:	Packed socket word of expected output levels
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint32_t inputs - Packed socket word of input levels
+********************************************************************/
+uint32_t CheckerEvaluate(const IC_PARAMETERS_T*, uint32_t);
+
+/********************************************************************
+* CheckerSetSettleOffset - Sets extra settle time for an IC pin
+*
+* Description:  Sets the extra settle time added to CYCLES_DELAY when
+* 				reading the given IC pin. Used to compensate for slow
+* 				socket contacts found by fixture calibration.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* 				uint16_t cycles - Extra settle time in SYSCLK cycles
+********************************************************************/
+void CheckerSetSettleOffset(uint8_t, uint16_t);
+
+/********************************************************************
+* CheckerGetSettle - Returns the settle time of an IC
+*
+* Description:  Gives the settle time used when reading the outputs
+* 				of the IC: the drive profile base settle time (or
+* 				CYCLES_DELAY) plus the largest calibration offset of
+* 				its output pins.
+*
+* Return value:	Settle time in SYSCLK cycles
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC
+* 				parameters
+********************************************************************/
+uint16_t CheckerGetSettle(const IC_PARAMETERS_T*);
+
+/********************************************************************
+* CheckerInvalidateProgram - Discards the compiled vector program
+*
+* Description:  The next test compiles its IC again. Used when an IC
+* 				definition changes.
+*
+* Return value:	None
+*
+* Arguments:    None
+********************************************************************/
+void CheckerInvalidateProgram(void);
+
+/********************************************************************
+* CheckerSetVoteSamples - Sets extra samples taken on a mismatch
+*
+* Description:  When an output read disagrees with the expected level
+* 				the outputs are sampled this many more times and each
+* 				output takes the majority level before the vector is
+* 				failed. Reads that agree cost nothing extra. 0 disables
+* 				voting. CHECKER_VOTE_DEFAULT by default.
+*
+* Return value:	None
+*
+* Arguments:    uint8_t extra_samples - Extra samples (even, up to
+* 				CHECKER_VOTE_MAX)
+********************************************************************/
+void CheckerSetVoteSamples(uint8_t);
+
+/********************************************************************
+* CheckerGetVoteStats - Returns majority vote counters
+*
+* Description:  Gives read access to the counts of votes taken and of
+* 				votes that overturned the first sample, kept since
+* 				reset or the last CheckerClearVoteStats.
+*
+* Return value:	Pointer to vote counters
+*
+* Arguments:    None
+********************************************************************/
+const CHECKER_VOTE_STATS_T *CheckerGetVoteStats(void);
+
+/********************************************************************
+* CheckerClearVoteStats - Clears majority vote counters
+*
+* Return value:	None
+*
+* Arguments:    None
+********************************************************************/
+void CheckerClearVoteStats(void);
+
+/********************************************************************
+* CheckerSetDrive - Sets drive profile of an IC
+*
+* Description:  The profile is applied every time the IC is tested (see
+* 				CHECKER_DRIVE_T).
+*
+* Return value:	None
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to set profile of
+*
+* 				const CHECKER_DRIVE_T *drive - Drive profile
+********************************************************************/
+void CheckerSetDrive(IC_DESIGNATOR_T, const CHECKER_DRIVE_T*);
+
+/********************************************************************
+* CheckerGetDrive - Returns drive profile of an IC
+*
+* Description:  Gives read access to the drive profile of an IC.
+*
+* Return value:	Pointer to drive profile
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to get profile of
+********************************************************************/
+const CHECKER_DRIVE_T *CheckerGetDrive(IC_DESIGNATOR_T);
+
+/********************************************************************
+* CheckerMeasureDrive - Measures settle time at each drive speed
+*
+* Description:  Run on a known-good part. Tests it at every output
+* 				speed (keeping the rest of its drive profile) and finds
+* 				the shortest settle time it passes with at each.
+*
+* Return value:	Index of the speed with the shortest settle time that
+* 				passed with no misreads, CHECKER_NO_DRIVE if none did
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				CHECKER_DRIVE_RESULT_T *results - CHECKER_NUM_SPEEDS
+* 				results, slowest speed first
+********************************************************************/
+uint8_t CheckerMeasureDrive(IC_PARAMETERS_T*, CHECKER_DRIVE_RESULT_T*);
+
+/********************************************************************
+* CheckerGetResult - Returns most recent test result record
+*
+* Description:  Gives read access to the result record filled in by
+* 				the last CheckerTestIC call.
+*
+* Return value:	Pointer to result record
+*
+* Arguments:    None
+********************************************************************/
+const CHECKER_RESULT_T *CheckerGetResult(void);
+
+/********************************************************************
+* CheckerRetestFailures - Replays the failing vectors of a reject
+*
+* Description:  After CheckerTestIC rejects a gate IC on failing
+* 				vectors, replays only those vectors (the full failing
+* 				set when diagnosis ran, otherwise the first failing
+* 				vector), optionally with a longer settle, and logs the
+* 				outcome against the original failure. Every input is
+* 				driven to the level it had when each vector was first
+* 				applied, so bridges between gates are retested. Takes
+* 				microseconds, so a re-seated IC failing on a contact
+* 				problem is cleared without a second full test. Can be
+* 				repeated until the next CheckerTestIC.
+*
+* Return value:	PASSED if every replayed vector passed, failure if any
+* 				still fail, CHECKER_NO_RETEST if there is no failure to
+* 				retest
+*
+* Arguments:    uint16_t extra_settle_cycles - SYSCLK cycles added to
+* 				the settle time of every replayed vector
+********************************************************************/
+uint8_t CheckerRetestFailures(uint16_t);
+
+/********************************************************************
+* CheckerGetRetestLog - Returns a logged retest outcome
+*
+* Description:  Gives read access to the retest log, newest first.
+*
+* Return value:	Pointer to retest outcome, 0 if not that many logged
+*
+* Arguments:    uint8_t age - 0 for the latest retest, up to
+* 				CHECKER_RETEST_LOG_SIZE - 1
+********************************************************************/
+const CHECKER_RETEST_T *CheckerGetRetestLog(uint8_t);
+
 #endif /* CHECKER_H_ */
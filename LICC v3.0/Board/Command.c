@@ -0,0 +1,938 @@
+/******************************************************************************
+* 	Command.c
+*
+* 	This source file runs a compact binary command set over USART1 for
+* 	poking socket pins from a PC. Commands are received into a ring by
+* 	circular DMA and found by polling the DMA count, so no per byte
+* 	interrupts are taken. Pins are given by IC pin number and mapped
+* 	through the same socket pin map the checker uses.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/16/2019:
+* 	Created binary pin control command set.
+*
+* 	08/17/2019:
+* 	Added IC upload and test commands.
+*
+* 	08/18/2019:
+* 	Added command entering host streamed vector mode.
+*
+* 	08/21/2019:
+* 	Added parametric output level command.
+*
+* 	08/22/2019:
+* 	IC test reply carries the logic family.
+*
+* 	08/24/2019:
+* 	Added over-current shutdown status command.
+*
+* 	08/26/2019:
+* 	IC upload carries the output type.
+*
+* 	08/27/2019:
+* 	Added failing vector retest command.
+*
+* 	08/28/2019:
+* 	IC test reply carries die temperature and VDDA.
+*
+* 	08/29/2019:
+* 	Added test engine stage profile command (Debug builds).
+*
+* 	08/30/2019:
+* 	Added logic analyzer capture command. Added pattern generator command.
+* 	Added unknown IC learn command.
+*
+* 	08/31/2019:
+* 	Added oscillation post-pass command. Added signature mode command.
+* 	Added fault log (vector order learning) command. Added test tier
+* 	command. Added drive profile set and measure commands. Added logic
+* 	family classification command. Added IDDQ screening command.
+*
+* 	Created on: 08/16/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Usart1.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "UserIc.h"
+#include "VectorStream.h"
+#include "Parametric.h"
+#include "Family.h"
+#include "Learn.h"
+#include "FailLog.h"
+#include "Oscillation.h"
+#include "LogicAnalyzer.h"
+#include "PatternGen.h"
+#include "OverCurrent.h"
+#include "Iddq.h"
+#include "Profile.h"
+#include "Command.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define CMD_RING_BYTES 64U
+// Receive ring length, must be a power of 2
+
+#define CMD_MAX_ARGS 30U
+#define CMD_MAX_REPLY 12U
+
+#define CMD_U16(bytes, index) ((uint16_t)((bytes)[(index)] | ((bytes)[(index) + 1U] << 8)))
+#define CMD_U32(bytes, index) ((uint32_t)CMD_U16((bytes), (index)) | ((uint32_t)CMD_U16((bytes), (index) + 2U) << 16))
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint8_t commandRing[CMD_RING_BYTES];
+static uint8_t commandRead;
+static uint8_t commandArgs[CMD_MAX_ARGS];
+static uint8_t commandReply[CMD_MAX_REPLY];
+static uint16_t commandLatencyLast;
+static uint16_t commandLatencyMin = 0xFFFFU;
+static uint16_t commandLatencyMax;
+
+static const uint8_t commandArgLen[CMD_LAST + 1] = {
+	0U,		// (unused)
+	2U,		// CMD_DIRECTION
+	4U,		// CMD_DRIVE
+	0U,		// CMD_READ
+	4U,		// CMD_PULSE
+	6U,		// CMD_READ_AFTER
+	0U,		// CMD_LATENCY
+	30U,	// CMD_UPLOAD_IC
+	1U,		// CMD_TEST_IC
+	0U,		// CMD_CLEAR_IC
+	4U,		// CMD_STREAM_VECTORS
+	1U,		// CMD_PARAMETRIC
+	2U,		// CMD_OVERCURRENT
+	2U,		// CMD_RETEST
+	2U,		// CMD_PROFILE
+	20U,	// CMD_CAPTURE
+	10U,	// CMD_PATTERN
+	0U,		// CMD_LEARN
+	2U,		// CMD_OSCILLATION
+	1U,		// CMD_SIGNATURE
+	2U,		// CMD_FAIL_LOG
+	2U,		// CMD_TIER
+	7U,		// CMD_DRIVE_PROFILE
+	3U,		// CMD_MEASURE_DRIVE
+	1U,		// CMD_FAMILY
+	4U		// CMD_IDDQ
+};
+
+static const IC_PARAMETERS_T *const commandBuiltIn[IC_USER] = {
+	&IC_74HC00_PARAM, &IC_74HC02_PARAM, &IC_74HC04_PARAM, &IC_74HC08_PARAM,
+	&IC_74HC10_PARAM, &IC_74HC20_PARAM, &IC_74HC27_PARAM, &IC_74HC86_PARAM,
+	&IC_74HC164_PARAM, &IC_74HC393_PARAM
+};
+// Built-in ICs by designator
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint8_t commandExecute(uint8_t);
+static uint8_t commandUploadIC(void);
+static uint8_t commandTestIC(void);
+static uint8_t commandParametric(void);
+static uint8_t commandRetest(void);
+static uint8_t commandLearn(void);
+static uint8_t commandTier(void);
+static uint8_t commandDriveProfile(void);
+static uint8_t commandMeasureDrive(void);
+#ifdef CHECKER_PROFILE
+static uint8_t commandProfile(void);
+#endif
+static const IC_PARAMETERS_T *commandGetIC(uint8_t);
+static void commandRunMode(uint8_t);
+static void commandStreamVectors(void);
+static void commandCapture(void);
+static void commandPattern(void);
+static uint32_t commandPinsToMask(uint16_t);
+static uint16_t commandReadPins(void);
+static void commandWait(uint16_t);
+static void commandPutU16(uint8_t, uint16_t);
+
+/******************************************************************************
+* CommandInit - Public Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts USART1 circular DMA reception into the command ring.
+* 				Must be called again after any mode that uses DMA1 channel
+* 				5 for itself.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CommandInit(void)
+{
+	commandRead = 0U;
+	Usart1RxStart(commandRing, CMD_RING_BYTES, 1U);
+}
+
+/******************************************************************************
+* CommandPoll - Public Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Executes every complete command waiting in the receive
+* 				ring. A command is only taken once all of its argument
+* 				bytes are in. An unknown opcode is answered with CMD_NAK
+* 				and everything received so far is dropped. A host mode
+* 				command (vector stream, capture, pattern) runs the mode
+* 				once its reply has gone, then returns.
+*
+* Arguments:    None
+*
+* Return:		Number of commands executed
+******************************************************************************/
+uint8_t CommandPoll(void)
+{
+	uint16_t seen = TIMESTAMP_NOW();
+	uint8_t write = Usart1RxPos();
+	uint8_t available = (write - commandRead) & (CMD_RING_BYTES - 1U);
+	uint8_t executed = 0U;
+	uint8_t opcode;
+	uint8_t reply_len;
+
+	while(available != 0U){
+		opcode = commandRing[commandRead];
+
+		if((opcode == 0U) || (opcode > CMD_LAST)){
+			commandRead = write;
+			while(Usart1TxDone() == 0U){}
+			commandReply[0] = CMD_NAK;
+			Usart1Write(commandReply, 1U);
+			break;
+		}
+		if(available < (1U + commandArgLen[opcode])) break;
+
+		for(uint8_t index = 0; index < commandArgLen[opcode]; index++){
+			commandArgs[index] = commandRing[(commandRead + 1U + index) & (CMD_RING_BYTES - 1U)];
+		}
+		commandRead = (commandRead + 1U + commandArgLen[opcode]) & (CMD_RING_BYTES - 1U);
+		available -= 1U + commandArgLen[opcode];
+
+		// Reply buffer is read by DMA until the last reply has gone
+		while(Usart1TxDone() == 0U){}
+		commandReply[0] = opcode | CMD_REPLY_FLAG;
+		reply_len = 1U + commandExecute(opcode);
+		Usart1Write(commandReply, reply_len);
+
+		if(opcode == CMD_READ){
+			commandLatencyLast = TIMESTAMP_NOW() - seen;
+			if(commandLatencyLast < commandLatencyMin) commandLatencyMin = commandLatencyLast;
+			if(commandLatencyLast > commandLatencyMax) commandLatencyMax = commandLatencyLast;
+		}
+		executed++;
+		seen = TIMESTAMP_NOW();
+
+		// Host modes take over the receive DMA (or the socket), anything
+		// after the command belongs to the mode
+		if((opcode == CMD_STREAM_VECTORS) || (opcode == CMD_CAPTURE) || (opcode == CMD_PATTERN)){
+			commandRunMode(opcode);
+			break;
+		}
+	}
+
+	return executed;
+}
+
+/******************************************************************************
+* commandExecute - Private Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Carries out one command using the arguments in commandArgs
+* 				and writes any reply data after the reply opcode.
+*
+* Arguments:    uint8_t opcode - Command opcode
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandExecute(uint8_t opcode)
+{
+	uint32_t mask = commandPinsToMask(CMD_U16(commandArgs, 0U));
+	const IC_PARAMETERS_T *IC;
+	uint32_t levels;
+	uint32_t driven;
+
+	switch(opcode){
+	case CMD_DIRECTION:
+		SocketSetInputs(SOCKET_ALL_MASK & ~mask);
+		SocketSetOutputs(mask);
+		return 0U;
+
+	case CMD_DRIVE:
+		levels = commandPinsToMask(CMD_U16(commandArgs, 2U));
+		SOCKET_WRITE(levels, mask);
+		return 0U;
+
+	case CMD_READ:
+		commandPutU16(1U, commandReadPins());
+		return 2U;
+
+	case CMD_PULSE:
+		driven = (GPIOA->ODR & 0xFFFFU) | (GPIOB->ODR << 16);
+		SOCKET_WRITE(~driven, mask);
+		commandWait(CMD_U16(commandArgs, 2U));
+		SOCKET_WRITE(driven, mask);
+		return 0U;
+
+	case CMD_READ_AFTER:
+		levels = commandPinsToMask(CMD_U16(commandArgs, 2U));
+		SOCKET_WRITE(levels, mask);
+		commandWait(CMD_U16(commandArgs, 4U));
+		commandPutU16(1U, commandReadPins());
+		return 2U;
+
+	case CMD_LATENCY:
+		commandPutU16(1U, commandLatencyLast);
+		commandPutU16(3U, commandLatencyMin);
+		commandPutU16(5U, commandLatencyMax);
+		return 6U;
+
+	case CMD_UPLOAD_IC:
+		return commandUploadIC();
+
+	case CMD_TEST_IC:
+		return commandTestIC();
+
+	case CMD_CLEAR_IC:
+		UserIcClear();
+		return 0U;
+
+	case CMD_PARAMETRIC:
+		return commandParametric();
+
+	case CMD_OVERCURRENT:
+		if(CMD_U16(commandArgs, 0U) != 0U) OcSetLimit(CMD_U16(commandArgs, 0U));
+		commandPutU16(1U, OcGetStatus()->trips);
+		commandPutU16(3U, OcGetStatus()->limit_ua);
+		commandPutU16(5U, OcGetStatus()->response_cycles);
+		commandPutU16(7U, OcGetStatus()->worst_cycles);
+		return 8U;
+
+	case CMD_RETEST:
+		return commandRetest();
+
+	case CMD_PROFILE:
+#ifdef CHECKER_PROFILE
+		return commandProfile();
+#else
+		return 0U;
+#endif
+
+	case CMD_LEARN:
+		return commandLearn();
+
+	case CMD_OSCILLATION:
+		CheckerSetOscillationCheck(commandArgs[0]);
+		commandPutU16(1U, OscGetFlaggedPins());
+		commandPutU16(3U, OscGetFrequency(commandArgs[1]) & 0xFFFFU);
+		commandPutU16(5U, OscGetFrequency(commandArgs[1]) >> 16);
+		return 6U;
+
+	case CMD_SIGNATURE:
+		CheckerSetSignatureMode(commandArgs[0]);
+		commandReply[1] = CheckerGetResult()->sig_mismatch;
+		commandPutU16(2U, CheckerGetResult()->signature & 0xFFFFU);
+		commandPutU16(4U, CheckerGetResult()->signature >> 16);
+		return 5U;
+
+	case CMD_FAIL_LOG:
+		if(commandArgs[1] != 0U) FailLogClear();
+		CheckerSetLearning(commandArgs[0]);
+		commandPutU16(1U, FailLogCount(CheckerGetResult()->ic_designator, CheckerGetResult()->fault));
+		return 2U;
+
+	case CMD_TIER:
+		return commandTier();
+
+	case CMD_DRIVE_PROFILE:
+		return commandDriveProfile();
+
+	case CMD_MEASURE_DRIVE:
+		return commandMeasureDrive();
+
+	case CMD_FAMILY:
+		CheckerSetFamilyCheck(commandArgs[0]);
+		commandReply[1] = CheckerGetResult()->family;
+		return 1U;
+
+	case CMD_IDDQ:
+		IC = commandGetIC(commandArgs[1]);
+		if((IC != 0) && (CMD_U16(commandArgs, 2U) != 0U)){
+			IddqSetLimit(IC->ic_designator, CMD_U16(commandArgs, 2U));
+		}
+		CheckerSetIddqCheck(commandArgs[0]);
+		commandPutU16(1U, CheckerGetResult()->iddq_ua);
+		commandReply[3] = CheckerGetResult()->iddq_vector;
+		return 3U;
+
+	default:
+		return 0U;
+	}
+}
+
+/******************************************************************************
+* commandUploadIC - Private Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/26/2019:	Anthony Needles
+* 				Output type byte added.
+*
+* Description:  Unpacks an uploaded IC from the command arguments and hands
+* 				it to UserIcStore.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandUploadIC(void)
+{
+	USERIC_DESCRIPTOR_T desc;
+	IC_DESIGNATOR_T ic_designator = IC_USER;
+	const uint8_t *args = commandArgs;
+	uint8_t index;
+
+	for(index = 0; index < USERIC_NAME_LEN; index++) desc.name[index] = *args++;
+	desc.num_gates = *args++;
+	desc.gate_inputs = *args++;
+	for(index = 0; index < 9U; index++) desc.input_pins[index] = *args++;
+	for(index = 0; index < 8U; index++) desc.output_pins[index] = *args++;
+	desc.truth_table = CMD_U16(args, 0U);
+	desc.output_type = args[2];
+
+	commandReply[1] = UserIcStore(&desc, &ic_designator);
+	commandReply[2] = ic_designator;
+	return 2U;
+}
+
+/******************************************************************************
+* commandTestIC - Private Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/28/2019:	Anthony Needles
+* 				Test conditions added to the reply.
+*
+* Description:  Tests the socket as the given built-in or uploaded IC.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandTestIC(void)
+{
+	const IC_PARAMETERS_T *IC = commandGetIC(commandArgs[0]);
+	const CHECKER_RESULT_T *result;
+
+	if(IC == 0){
+		commandReply[1] = 0U;
+		commandReply[2] = CHECKER_NO_VECTOR;
+		commandPutU16(3U, 0U);
+		commandReply[5] = FAMILY_UNKNOWN;
+		commandPutU16(6U, 0U);
+		commandPutU16(8U, 0U);
+		return 9U;
+	}
+
+	commandReply[1] = CheckerTestIC(*IC);
+	result = CheckerGetResult();
+	commandReply[2] = result->fail_vector;
+	commandPutU16(3U, result->fault);
+	commandReply[5] = result->family;
+	commandPutU16(6U, (uint16_t)result->temp_dc);
+	commandPutU16(8U, result->vdda_mv);
+	return 9U;
+}
+
+/******************************************************************************
+* commandParametric - Private Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Measures the output levels of the socket as the given
+* 				built-in or uploaded gate IC, replying with the worst
+* 				levels over all outputs.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandParametric(void)
+{
+	const IC_PARAMETERS_T *IC = commandGetIC(commandArgs[0]);
+	PARAM_RESULT_T result;
+	IC_PARAMETERS_T params;
+	uint16_t voh_mv = PARAM_NOT_MEASURED;
+	uint16_t vol_mv = 0U;
+
+	if(IC == 0){
+		commandReply[1] = 0U;
+		commandPutU16(2U, 0U);
+		commandPutU16(4U, 0U);
+		commandPutU16(6U, PARAM_NOT_MEASURED);
+		commandPutU16(8U, PARAM_NOT_MEASURED);
+		return 9U;
+	}
+
+	params = *IC;
+	commandReply[1] = ParamMeasure(&params, &result);
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(result.voh_mv[ic_pin] < voh_mv) voh_mv = result.voh_mv[ic_pin];
+		if((result.vol_mv[ic_pin] != PARAM_NOT_MEASURED) && (result.vol_mv[ic_pin] > vol_mv)) vol_mv = result.vol_mv[ic_pin];
+	}
+	commandPutU16(2U, result.vdd_mv);
+	commandPutU16(4U, result.fail_pins);
+	commandPutU16(6U, voh_mv);
+	commandPutU16(8U, vol_mv);
+	return 9U;
+}
+
+/******************************************************************************
+* commandRetest - Private Function
+*
+* 08/27/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Replays the failing vectors of the last rejected IC with
+* 				the given extra settle time, replying with the logged
+* 				outcome and the original failure it was logged against.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandRetest(void)
+{
+	const CHECKER_RETEST_T *retest;
+
+	commandReply[1] = CheckerRetestFailures(CMD_U16(commandArgs, 0U));
+	if(commandReply[1] == CHECKER_NO_RETEST){
+		commandReply[2] = 0U;
+		commandReply[3] = 0U;
+		commandReply[4] = 0U;
+		commandPutU16(5U, 0U);
+		commandReply[7] = CHECKER_NO_VECTOR;
+		return 7U;
+	}
+
+	retest = CheckerGetRetestLog(0U);
+	commandReply[2] = retest->attempt;
+	commandReply[3] = retest->num_retested;
+	commandReply[4] = retest->num_failing;
+	commandPutU16(5U, retest->fault);
+	commandReply[7] = retest->fail_vector;
+	return 7U;
+}
+
+/******************************************************************************
+* commandLearn - Private Function
+*
+* 08/30/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Characterizes the IC in the socket (see LearnRun) and
+* 				replies with the matching library IC, the truth table
+* 				signature and the pin directions found.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandLearn(void)
+{
+	const LEARN_RESULT_T *result;
+
+	commandReply[1] = LearnRun();
+	result = LearnGetResult();
+	commandPutU16(2U, result->signature & 0xFFFFU);
+	commandPutU16(4U, result->signature >> 16);
+	commandPutU16(6U, result->in_pins);
+	commandPutU16(8U, result->out_pins);
+	return 9U;
+}
+
+/******************************************************************************
+* commandTier - Private Function
+*
+* 08/31/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Selects the test tier and replies with its vector count and
+* 				duration on the given IC, followed by the high-Z and timing
+* 				results of the last test.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandTier(void)
+{
+	const IC_PARAMETERS_T *IC = commandGetIC(commandArgs[0]);
+	const CHECKER_RESULT_T *result = CheckerGetResult();
+	CHECKER_TIER_INFO_T info = {0};
+	IC_PARAMETERS_T params;
+
+	if(commandArgs[1] <= CHECKER_TIER_CHARACTERIZE){
+		CheckerSetTier((CHECKER_TIER_T)commandArgs[1]);
+		if(IC != 0){
+			params = *IC;
+			CheckerGetTierInfo(&params, (CHECKER_TIER_T)commandArgs[1], &info);
+		}
+	}
+
+	commandReply[1] = info.num_vectors;
+	commandPutU16(2U, info.duration_us & 0xFFFFU);
+	commandPutU16(4U, info.duration_us >> 16);
+	commandPutU16(6U, result->hiz_pins);
+	commandPutU16(8U, result->max_delay_cycles);
+	commandPutU16(10U, result->min_settle_cycles);
+	return 11U;
+}
+
+/******************************************************************************
+* commandDriveProfile - Private Function
+*
+* 08/31/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the drive profile of an IC from the command arguments.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandDriveProfile(void)
+{
+	CHECKER_DRIVE_T drive;
+
+	drive.speed = (SOCKET_SPEED_T)commandArgs[1];
+	drive.output_pull = (SOCKET_PULL_T)commandArgs[2];
+	drive.slow_pins = CMD_U16(commandArgs, 3U);
+	drive.settle_cycles = CMD_U16(commandArgs, 5U);
+
+	CheckerSetDrive((IC_DESIGNATOR_T)commandArgs[0], &drive);
+	return 0U;
+}
+
+/******************************************************************************
+* commandMeasureDrive - Private Function
+*
+* 08/31/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Measures the settle time of the IC in the socket at each
+* 				output speed and applies the best speed, with its settle
+* 				time plus the given guard band, to the IC drive profile.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandMeasureDrive(void)
+{
+	const IC_PARAMETERS_T *IC = commandGetIC(commandArgs[0]);
+	CHECKER_DRIVE_RESULT_T results[CHECKER_NUM_SPEEDS] = {{0}};
+	CHECKER_DRIVE_T drive;
+	IC_PARAMETERS_T params;
+	uint16_t guard = CMD_U16(commandArgs, 1U);
+	uint8_t best = CHECKER_NO_DRIVE;
+
+	if(IC != 0){
+		params = *IC;
+		best = CheckerMeasureDrive(&params, results);
+	}
+
+	if(best != CHECKER_NO_DRIVE){
+		drive = *CheckerGetDrive(params.ic_designator);
+		drive.speed = results[best].speed;
+		drive.settle_cycles = (guard > (0xFFFFU - results[best].min_settle_cycles))
+							  ? 0xFFFFU : (results[best].min_settle_cycles + guard);
+		CheckerSetDrive(params.ic_designator, &drive);
+	}
+
+	commandReply[1] = best;
+	for(uint8_t index = 0; index < CHECKER_NUM_SPEEDS; index++){
+		commandPutU16(2U + (2U * index), results[index].min_settle_cycles);
+	}
+	return 1U + (2U * CHECKER_NUM_SPEEDS);
+}
+
+#ifdef CHECKER_PROFILE
+/******************************************************************************
+* commandProfile - Private Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Replies with the counters of one test engine stage of an IC
+* 				type, or clears every counter for designator
+* 				CMD_PROFILE_CLEAR.
+*
+* Arguments:    None
+*
+* Return:		Number of reply data bytes
+******************************************************************************/
+static uint8_t commandProfile(void)
+{
+	PROFILE_STATS_T stats = {0};
+
+	if(commandArgs[0] == CMD_PROFILE_CLEAR) ProfileClear();
+	else ProfileGet((IC_DESIGNATOR_T)commandArgs[0], (PROFILE_STAGE_T)commandArgs[1], &stats);
+
+	commandPutU16(1U, stats.total_cycles & 0xFFFFU);
+	commandPutU16(3U, stats.total_cycles >> 16);
+	commandPutU16(5U, stats.count & 0xFFFFU);
+	commandPutU16(7U, stats.count >> 16);
+	commandPutU16(9U, stats.max_cycles);
+	return 10U;
+}
+#endif
+
+/******************************************************************************
+* commandGetIC - Private Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function (from commandTestIC).
+*
+* Description:  Looks up the parameters of a built-in or uploaded IC.
+*
+* Arguments:    uint8_t ic_designator - IC designator
+*
+* Return:		Pointer to IC parameters, 0 if there is no such IC
+******************************************************************************/
+static const IC_PARAMETERS_T *commandGetIC(uint8_t ic_designator)
+{
+	return (ic_designator < IC_USER) ? commandBuiltIn[ic_designator] : UserIcGet((IC_DESIGNATOR_T)ic_designator);
+}
+
+/******************************************************************************
+* commandRunMode - Private Function
+*
+* 08/30/2019:	Anthony Needles
+* 				Started and completed function (from
+* 				commandStreamVectors).
+*
+* Description:  Runs a host mode once the command reply has gone, then
+* 				restarts the command ring.
+*
+* Arguments:    uint8_t opcode - Command opcode
+*
+* Return:		None
+******************************************************************************/
+static void commandRunMode(uint8_t opcode)
+{
+	Usart1Flush();
+
+	switch(opcode){
+	case CMD_STREAM_VECTORS:
+		commandStreamVectors();
+		break;
+
+	case CMD_CAPTURE:
+		commandCapture();
+		break;
+
+	case CMD_PATTERN:
+		commandPattern();
+		break;
+
+	default:
+		break;
+	}
+
+	CommandInit();
+}
+
+/******************************************************************************
+* commandStreamVectors - Private Function
+*
+* 08/18/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Reply flush and ring restart moved to commandRunMode.
+*
+* Description:  Runs a host vector stream.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void commandStreamVectors(void)
+{
+	VS_CONFIG_T config;
+
+	config.drive_pins = CMD_U16(commandArgs, 0U);
+	config.settle_cycles = CMD_U16(commandArgs, 2U);
+
+	VsRun(&config);
+}
+
+/******************************************************************************
+* commandCapture - Private Function
+*
+* 08/30/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Runs a logic analyzer capture with the settings in the
+* 				command arguments, then streams it to the host.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void commandCapture(void)
+{
+	LA_CONFIG_T config;
+
+	config.rate_hz = CMD_U32(commandArgs, 0U);
+	config.trig_pins = CMD_U16(commandArgs, 4U);
+	config.trig_levels = CMD_U16(commandArgs, 6U);
+	config.pre_samples = CMD_U32(commandArgs, 8U);
+	config.post_samples = CMD_U32(commandArgs, 12U);
+	config.timeout_ms = CMD_U32(commandArgs, 16U);
+
+	LaCapture(&config);
+	LaStream();
+}
+
+/******************************************************************************
+* commandPattern - Private Function
+*
+* 08/30/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Plays a pattern out of the socket. With a step count the
+* 				pattern is first received from the host (PgLoad) and then
+* 				played as set by the loop count, otherwise it is streamed
+* 				from the host (PgStream). The reason playback ended is
+* 				sent as a second reply.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void commandPattern(void)
+{
+	PG_CONFIG_T config;
+	const uint32_t *steps;
+	uint16_t num_steps = CMD_U16(commandArgs, 8U);
+	PG_STATUS_T status;
+
+	config.rate_hz = CMD_U32(commandArgs, 0U);
+	config.drive_pins = CMD_U16(commandArgs, 4U);
+	config.loops = CMD_U16(commandArgs, 6U);
+
+	if(num_steps == 0U){
+		status = PgStream(&config);
+	} else {
+		steps = PgLoad(num_steps);
+		status = (steps != 0) ? PgPlay(&config, steps, num_steps) : PG_UNDERRUN;
+	}
+
+	commandReply[0] = CMD_PATTERN | CMD_REPLY_FLAG;
+	commandReply[1] = status;
+	Usart1Write(commandReply, 2U);
+	Usart1Flush();
+}
+
+/******************************************************************************
+* commandPinsToMask - Private Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a bit field of IC pins into a packed socket mask.
+* 				Power pins and unused bits are ignored.
+*
+* Arguments:    uint16_t ic_pins - Bit field of IC pins (bit n = IC pin n)
+*
+* Return:		Packed socket pin mask
+******************************************************************************/
+static uint32_t commandPinsToMask(uint16_t ic_pins)
+{
+	uint32_t mask = 0U;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(ic_pins & (1U << ic_pin)) mask |= SocketPinMask[ic_pin];
+	}
+	return mask;
+}
+
+/******************************************************************************
+* commandReadPins - Private Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Reads every socket pin in one port-wide read.
+*
+* Arguments:    None
+*
+* Return:		Bit field of IC pin levels (bit n = IC pin n)
+******************************************************************************/
+static uint16_t commandReadPins(void)
+{
+	uint32_t word = SOCKET_READ();
+	uint16_t ic_pins = 0U;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(word & SocketPinMask[ic_pin]) ic_pins |= (1U << ic_pin);
+	}
+	return ic_pins;
+}
+
+/******************************************************************************
+* commandWait - Private Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits the given number of SYSCLK cycles on the timestamp
+* 				counter.
+*
+* Arguments:    uint16_t cycles - Cycles to wait
+*
+* Return:		None
+******************************************************************************/
+static void commandWait(uint16_t cycles)
+{
+	uint16_t start = TIMESTAMP_NOW();
+
+	while((uint16_t)(TIMESTAMP_NOW() - start) < cycles){}
+}
+
+/******************************************************************************
+* commandPutU16 - Private Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Writes a little endian u16 into the reply buffer.
+*
+* Arguments:    uint8_t index - Reply byte offset
+*
+* 				uint16_t value - Value to write
+*
+* Return:		None
+******************************************************************************/
+static void commandPutU16(uint8_t index, uint16_t value)
+{
+	commandReply[index] = value & 0xFFU;
+	commandReply[index + 1U] = value >> 8;
+}
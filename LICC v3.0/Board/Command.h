@@ -0,0 +1,238 @@
+/******************************************************************************
+* 	Command.h
+*
+* 	Header for Command.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/16/2019:
+* 	Created binary pin control command set.
+*
+* 	08/17/2019:
+* 	Added IC upload and test commands.
+*
+* 	08/18/2019:
+* 	Added command entering host streamed vector mode.
+*
+* 	08/21/2019:
+* 	Added parametric output level command.
+*
+* 	08/22/2019:
+* 	IC test reply carries the logic family.
+*
+* 	08/24/2019:
+* 	Added over-current shutdown status command.
+*
+* 	08/26/2019:
+* 	IC upload carries the output type.
+*
+* 	08/27/2019:
+* 	Added failing vector retest command.
+*
+* 	08/28/2019:
+* 	IC test reply carries die temperature and VDDA.
+*
+* 	08/29/2019:
+* 	Added test engine stage profile command (Debug builds).
+*
+* 	08/30/2019:
+* 	Added logic analyzer capture command. Added pattern generator command.
+* 	Added unknown IC learn command.
+*
+* 	08/31/2019:
+* 	Added oscillation post-pass command. Added signature mode command.
+* 	Added fault log (vector order learning) command. Added test tier
+* 	command. Added drive profile set and measure commands. Added logic
+* 	family classification command. Added IDDQ screening command.
+*
+* 	Created on: 08/16/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef COMMAND_H_
+#define COMMAND_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define CMD_DIRECTION 0x01U
+// Args: u16 output pins. Listed pins are driven, the rest are inputs.
+
+#define CMD_DRIVE 0x02U
+// Args: u16 pins, u16 levels. Sets the listed output pins to their levels.
+
+#define CMD_READ 0x03U
+// Args: none. Reply: u16 levels of every socket pin.
+
+#define CMD_PULSE 0x04U
+// Args: u16 pins, u16 cycles. Inverts the listed output pins for the given
+// number of SYSCLK cycles then restores them.
+
+#define CMD_READ_AFTER 0x05U
+// Args: u16 pins, u16 levels, u16 cycles. Drives as CMD_DRIVE, waits the
+// given number of SYSCLK cycles, then reads. Reply: u16 levels.
+
+#define CMD_LATENCY 0x06U
+// Args: none. Reply: u16 last, u16 min, u16 max turnaround of CMD_READ in
+// SYSCLK cycles, from the command being seen in the receive ring to its
+// reply being handed to transmit DMA.
+
+#define CMD_UPLOAD_IC 0x07U
+// Args: USERIC_DESCRIPTOR_T as bytes (name[8], gates, inputs per gate,
+// input pins[9], output pins[8], u16 truth table, u8 output type). Reply:
+// u8 UserIcStore result, u8 designator given.
+
+#define CMD_TEST_IC 0x08U
+// Args: u8 designator (built-in or user). Reply: u8 passed, u8 failing
+// vector, u16 diagnosed fault, u8 logic family (FAMILY_T, when enabled by
+// CMD_FAMILY), s16 die temperature (0.1C), u16 VDDA (mV).
+
+#define CMD_CLEAR_IC 0x09U
+// Args: none. Erases every uploaded IC.
+
+#define CMD_STREAM_VECTORS 0x0AU
+// Args: u16 driven pins, u16 settle cycles (see VS_CONFIG_T). After the
+// reply the device runs VsRun (see VectorStream.h) and then returns to
+// taking commands.
+
+#define CMD_PARAMETRIC 0x0BU
+// Args: u8 designator (built-in or user gate IC). Reply: u8 passed, u16 VDD,
+// u16 failing output pins, u16 lowest VOH, u16 highest VOL (mV, see
+// Parametric.h).
+
+#define CMD_OVERCURRENT 0x0CU
+// Args: u16 over-current limit in uA (0 keeps the limit). Reply: u16 trips,
+// u16 limit, u16 response and u16 worst case shutdown time in SYSCLK cycles
+// (see OC_STATUS_T).
+
+#define CMD_RETEST 0x0DU
+// Args: u16 SYSCLK cycles added to the settle time. Replays the failing
+// vectors of the last rejected IC (see CheckerRetestFailures). Reply: u8
+// result (PASSED, 0 or CHECKER_NO_RETEST), u8 retest number, u8 vectors
+// replayed, u8 vectors still failing, u16 original diagnosed fault, u8
+// original failing vector.
+
+#define CMD_PROFILE 0x0EU
+// Args: u8 designator, u8 stage (PROFILE_STAGE_T). Reply: u32 total SYSCLK
+// cycles, u32 times timed, u16 longest time of the stage for the IC type
+// (see Profile.h). Only the last IC type tested has counters, others reply
+// zeros. Designator CMD_PROFILE_CLEAR clears every counter and replies
+// zeros. Without CHECKER_PROFILE (release builds) the reply has no data.
+
+#define CMD_PROFILE_CLEAR 0xFFU
+
+#define CMD_CAPTURE 0x0FU
+// Args: LA_CONFIG_T as bytes (u32 sample rate, u16 trigger pins, u16
+// trigger levels, u32 pre-trigger samples, u32 post-trigger samples, u32
+// timeout ms). After the reply the device runs LaCapture, streams the
+// capture with LaStream (LA_HEADER_T then the RLE entries, see
+// LogicAnalyzer.h) and then returns to taking commands. Any byte sent
+// before the trigger stops the capture (LA_FLAG_STOPPED), the only way out
+// with a 0 timeout.
+
+#define CMD_PATTERN 0x10U
+// Args: u32 step rate, u16 driven pins, u16 loops (see PG_CONFIG_T), u16
+// steps. After the reply the host sends the given number of u32 pattern
+// entries, which are played (PgLoad, PgPlay), or with 0 steps streams
+// them (PgStream, see PatternGen.h). When playback ends a second reply
+// carries u8 PG_STATUS_T (PG_UNDERRUN if a loaded pattern did not arrive)
+// and the device returns to taking commands.
+
+#define CMD_LEARN 0x11U
+// Args: none. Characterizes the IC in the socket (see LearnRun). Reply: u8
+// matching designator (LEARN_NO_MATCH for a new function), u32 truth table
+// signature, u16 input pins, u16 output pins.
+
+#define CMD_OSCILLATION 0x12U
+// Args: u8 enable (1 or 0), u8 IC pin. Enables or disables the oscillation
+// post-pass of passing ICs (see CheckerSetOscillationCheck). Reply: u16
+// pins flagged by the last post-pass, u32 frequency estimate of the given
+// pin (Hz, 0 if not flagged, see OscGetFrequency).
+
+#define CMD_SIGNATURE 0x13U
+// Args: u8 enable (1 or 0). Enables or disables response signature mode
+// (see CheckerSetSignatureMode). Reply: u8 whether the last test saw a
+// signature mismatch, u32 last measured signature.
+
+#define CMD_FAIL_LOG 0x14U
+// Args: u8 enable (1 or 0), u8 clear (1 erases the log). Enables or disables
+// logging the faults of rejected ICs to flash and ordering vectors by them
+// (see CheckerSetLearning). Every logged reject writes one halfword and the
+// log page is erased once per FAILLOG_NUM_RECORDS rejects, so the rated
+// 1k erase cycles of the page last ~500k logged rejects. Reply: u16 times
+// the fault diagnosed on the last rejected IC has been logged.
+
+#define CMD_TIER 0x15U
+// Args: u8 designator (built-in or user), u8 tier (CHECKER_TIER_T). Selects
+// the tier run by CMD_TEST_IC (see CheckerSetTier). Reply: u8 vectors and
+// u32 estimated duration (us) of the tier on the IC (see
+// CheckerGetTierInfo, zeros for an unknown IC or tier), then from the last
+// test u16 outputs failing the high-Z check, u16 slowest propagation delay
+// and u16 shortest passing settle time (SYSCLK cycles, characterize only).
+
+#define CMD_DRIVE_PROFILE 0x16U
+// Args: u8 designator, u8 output speed (SOCKET_SPEED_T), u8 output pull
+// (SOCKET_PULL_T), u16 slow pins, u16 settle cycles. Sets the drive profile
+// of the IC (see CHECKER_DRIVE_T).
+
+#define CMD_MEASURE_DRIVE 0x17U
+// Args: u8 designator (built-in or user gate IC), u16 guard band cycles.
+// Run on a known-good part. Measures the shortest settle time at each
+// output speed (see CheckerMeasureDrive) and, if a speed read cleanly,
+// sets the IC drive profile to that speed with its settle time plus the
+// guard band, keeping the pulls and slow pins. Reply: u8 speed index
+// chosen (CHECKER_NO_DRIVE if none), u16 shortest settle time of each
+// speed, slowest first (0 if it failed).
+
+#define CMD_FAMILY 0x18U
+// Args: u8 enable (1 or 0). Enables or disables logic family classification
+// of passing gate ICs (see CheckerSetFamilyCheck), reported by CMD_TEST_IC.
+// Reply: u8 logic family of the last IC tested (FAMILY_T).
+
+#define CMD_IDDQ 0x19U
+// Args: u8 enable (1 or 0), u8 designator, u16 supply current limit of that
+// IC in uA (0 keeps the current limit). Enables or disables IDDQ screening
+// (see CheckerSetIddqCheck). Reply: u16 worst supply current (uA) and u8
+// worst vector of the last IC tested (IDDQ_NO_VECTOR if not sampled).
+
+#define CMD_LAST CMD_IDDQ
+
+#define CMD_REPLY_FLAG 0x80U
+// Every command is answered with its opcode | CMD_REPLY_FLAG, followed by
+// any reply data. u16 values are little endian, pin fields hold IC pin n
+// in bit n.
+
+#define CMD_NAK 0xFFU
+// Reply to an unknown opcode. The receive ring is emptied to resync.
+
+/******************************************************************************
+* CommandInit - Public Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts USART1 circular DMA reception into the command ring.
+* 				Must be called again after any mode that uses DMA1 channel
+* 				5 for itself.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CommandInit(void);
+
+/******************************************************************************
+* CommandPoll - Public Function
+*
+* 08/16/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Executes every complete command waiting in the receive
+* 				ring.
+*
+* Arguments:    None
+*
+* Return:		Number of commands executed
+******************************************************************************/
+uint8_t CommandPoll(void);
+
+#endif /* COMMAND_H_ */
@@ -0,0 +1,205 @@
+/******************************************************************************
+* 	Conditions.c
+*
+* 	This source file keeps the die temperature and analog supply (VDDA) the
+* 	board tests at, so results from different stations can be compared.
+* 	While the ADC is otherwise unused it converts the internal temperature
+* 	sensor and VREFINT continuously in the background, DMA1 channel 1
+* 	filling a circular buffer. Each half buffer is averaged in the DMA
+* 	interrupt into a running average, so taking the conditions for a test
+* 	only copies two values.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/28/2019:
+* 	Created background die temperature and VDDA measurement.
+*
+* 	Created on: 08/28/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Adc.h"
+#include "Conditions.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define COND_CHANNELS ((1UL << ADC_CHANNEL_TEMP) | (1UL << ADC_CHANNEL_VREFINT))
+// Temperature sensor then VREFINT, converted as one scan sequence
+
+#define COND_SEQUENCES 16U
+// Scan sequences per half buffer, a DMA interrupt every ~670us
+
+#define COND_BUFFER_LEN (2U * 2U * COND_SEQUENCES)
+
+#define COND_FILTER_SHIFT 3U
+// Running average weight of each half buffer (1/8), averaging over ~5ms
+
+#define COND_AVG_SCALE COND_SEQUENCES
+// Averages are kept as readings x COND_AVG_SCALE, the sum of a half buffer
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint16_t condSamples[COND_BUFFER_LEN];
+static uint32_t condTempAvg;
+static uint32_t condVrefAvg;
+static volatile int16_t condTempDc;
+static volatile uint16_t condVddaMv;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static void condAverage(const uint16_t*);
+static void condConvert(void);
+
+/******************************************************************************
+* CondInit - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Seeds the averages with one scan of the temperature sensor
+* 				and VREFINT and enables the DMA interrupt that updates them,
+* 				at the lowest priority. AdcInit must have been called.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CondInit(void)
+{
+	uint16_t samples[2];
+
+	AdcScan(COND_CHANNELS, samples);
+	condTempAvg = (uint32_t)samples[0] * COND_AVG_SCALE;
+	condVrefAvg = (uint32_t)samples[1] * COND_AVG_SCALE;
+	condConvert();
+
+	NVIC_SetPriority(DMA1_Channel1_IRQn, 3U);
+	NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+}
+
+/******************************************************************************
+* CondService - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Restarts background conversion if the ADC was taken for
+* 				anything else. Called from the main loop, where the ADC is
+* 				always free.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CondService(void)
+{
+	AdcBackgroundStart(COND_CHANNELS, condSamples, COND_BUFFER_LEN);
+}
+
+/******************************************************************************
+* CondGet - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives the running averages of die temperature and VDDA.
+* 				Only copies values kept up to date in the background.
+*
+* Arguments:    int16_t *temp_dc - Returns die temperature in 0.1C
+*
+* 				uint16_t *vdda_mv - Returns VDDA in mV
+*
+* Return:		None
+******************************************************************************/
+void CondGet(int16_t *temp_dc, uint16_t *vdda_mv)
+{
+	*temp_dc = condTempDc;
+	*vdda_mv = condVddaMv;
+}
+
+/******************************************************************************
+* condAverage - Private Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sums the sequences of a half buffer and moves the running
+* 				averages 1/2^COND_FILTER_SHIFT of the way towards them.
+*
+* Arguments:    const uint16_t *samples - First result of the half buffer
+*
+* Return:		None
+******************************************************************************/
+static void condAverage(const uint16_t *samples)
+{
+	uint32_t temp_sum = 0U;
+	uint32_t vref_sum = 0U;
+
+	for(uint8_t sequence = 0; sequence < COND_SEQUENCES; sequence++){
+		temp_sum += samples[2U * sequence];
+		vref_sum += samples[(2U * sequence) + 1U];
+	}
+
+	condTempAvg = condTempAvg - (condTempAvg >> COND_FILTER_SHIFT) + (temp_sum >> COND_FILTER_SHIFT);
+	condVrefAvg = condVrefAvg - (condVrefAvg >> COND_FILTER_SHIFT) + (vref_sum >> COND_FILTER_SHIFT);
+}
+
+/******************************************************************************
+* condConvert - Private Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts the running averages into VDDA and die temperature.
+* 				VDDA comes from the VREFINT calibration. The sensor reading
+* 				is scaled to the calibration supply and its difference
+* 				from the 30C calibration divided by the sensor slope.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void condConvert(void)
+{
+	int32_t difference;
+	uint16_t vdda_mv;
+
+	if(condVrefAvg == 0U) return;
+	vdda_mv = (uint16_t)(((uint32_t)ADC_CAL_MV * ADC_VREFINT_CAL * COND_AVG_SCALE) / condVrefAvg);
+
+	// mV x counts x COND_AVG_SCALE, positive when hotter than calibration
+	difference = ((int32_t)ADC_TS_CAL * ADC_CAL_MV * COND_AVG_SCALE) - ((int32_t)condTempAvg * vdda_mv);
+
+	condVddaMv = vdda_mv;
+	difference /= (int32_t)COND_AVG_SCALE;
+	condTempDc = (int16_t)(COND_TS_CAL_DC + ((difference * 100) / ((int32_t)ADC_FULL_SCALE * COND_TS_SLOPE_X10)));
+}
+
+/******************************************************************************
+* DMA1_Channel1_IRQHandler - Interrupt Handler
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Half of the background buffer was filled. Averages that
+* 				half while DMA fills the other, and updates the conditions.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void DMA1_Channel1_IRQHandler(void)
+{
+	if(DMA1->ISR & DMA_ISR_HTIF1){
+		DMA1->IFCR = DMA_IFCR_CHTIF1;
+		condAverage(&condSamples[0]);
+	}
+	if(DMA1->ISR & DMA_ISR_TCIF1){
+		DMA1->IFCR = DMA_IFCR_CTCIF1;
+		condAverage(&condSamples[COND_BUFFER_LEN / 2U]);
+	}
+	condConvert();
+}
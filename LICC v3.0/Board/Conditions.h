@@ -0,0 +1,75 @@
+/******************************************************************************
+* 	Conditions.h
+*
+* 	Header for Conditions.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/28/2019:
+* 	Created background die temperature and VDDA measurement.
+*
+* 	Created on: 08/28/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef CONDITIONS_H_
+#define CONDITIONS_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define COND_TS_SLOPE_X10 43U
+// Temperature sensor average slope, 4.3mV per C (typical)
+
+#define COND_TS_CAL_DC 300
+// Temperature of the factory sensor calibration (30.0C)
+
+/******************************************************************************
+* CondInit - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Seeds the averages with one scan of the temperature sensor
+* 				and VREFINT and enables the DMA interrupt that updates them.
+* 				AdcInit must have been called.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CondInit(void);
+
+/******************************************************************************
+* CondService - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Restarts background conversion if the ADC was taken for
+* 				anything else. Called from the main loop, where the ADC is
+* 				always free.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CondService(void);
+
+/******************************************************************************
+* CondGet - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives the running averages of die temperature and VDDA.
+* 				Only copies values kept up to date in the background.
+*
+* Arguments:    int16_t *temp_dc - Returns die temperature in 0.1C
+*
+* 				uint16_t *vdda_mv - Returns VDDA in mV
+*
+* Return:		None
+******************************************************************************/
+void CondGet(int16_t*, uint16_t*);
+
+#endif /* CONDITIONS_H_ */
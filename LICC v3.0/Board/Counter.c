@@ -0,0 +1,263 @@
+/******************************************************************************
+* 	Counter.c
+*
+* 	This source file tests binary ripple counters such as the 74HC393. The
+* 	DUT clock is generated in hardware: TIM1 compare 1 requests DMA1
+* 	channel 2 to write alternating reset/set words into the BSRR of the
+* 	clock pin port, and TIM1 compares 2 and 4 request DMA1 channels 3 and 4
+* 	to copy GPIOA and GPIOB IDR into sample buffers a fixed time after each
+* 	edge. The CPU only checks the captured sequence once the run completes.
+* 	No timer channel is routed to the counter clock pins (PB11 and PA1),
+* 	hence the clock is written through DMA rather than a timer output.
+* 	Dependent on 48MHz TIM1 clock and the TIM6 timestamp counter.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/12/2019:
+* 	Created hardware clocked binary counter test.
+*
+* 	08/31/2019:
+* 	Edge period and sample phase derived from the IC settle time from the
+* 	checker instead of a fixed 1us and 750ns. Test abandoned as soon as an
+* 	over-current floats the socket.
+*
+* 	Created on: 08/12/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "OverCurrent.h"
+#include "Counter.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+#define FAILED 0U
+
+#define COUNTER_PINS_SECTION 2U
+// Input pins (clock and reset) per counter section
+
+#define COUNTER_CLOCK_COMPARE 1U
+// TIM1 count of each clock edge within an edge period
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint32_t counterClockWords[2];
+static uint16_t counterSamplesA[COUNTER_MAX_EDGES];
+static uint16_t counterSamplesB[COUNTER_MAX_EDGES];
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint8_t counterRun(uint32_t, uint8_t, uint16_t);
+static void counterWait(uint16_t);
+
+/******************************************************************************
+* CounterInit - Public Function
+*
+* 08/12/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables clocks for TIM1 and DMA1, used to clock the DUT
+* 				and sample its outputs.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CounterInit(void)
+{
+	RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+	RCC->AHBENR |= RCC_AHBENR_DMAEN;
+}
+
+/******************************************************************************
+* CounterTest - Public Function
+*
+* 08/12/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Edges spaced by the IC settle time. Over-current checked
+* 				every section.
+*
+* Description:  Tests each section of a binary counter IC in turn, with
+* 				every other section held in reset. The section is reset
+* 				and checked, then its clock is run through the full count
+* 				twice (limited to COUNTER_MAX_CLOCKS) with the outputs
+* 				sampled after every edge. Each sample must hold the count
+* 				of falling edges so far, so a count on a rising edge, a
+* 				missed or extra count, a stuck bit or a disturbed section
+* 				all fail. Outputs are sampled the settle time the checker
+* 				uses for the IC after each edge and after each reset
+* 				change (see CheckerGetSettle), so slow socket pins found
+* 				by fixture calibration are waited for. The test stops
+* 				after the reset check or clock run in which an
+* 				over-current floated the socket.
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint8_t *fail_step - Failing step (section * (1 +
+* 				COUNTER_MAX_EDGES) + 0 for reset, + n for edge n)
+*
+* Return:		Test pass or test failure
+******************************************************************************/
+uint8_t CounterTest(const IC_PARAMETERS_T *IC, uint8_t *fail_step)
+{
+	uint8_t num_sections = IC->num_inputs / COUNTER_PINS_SECTION;
+	uint8_t num_bits = IC->num_outputs / num_sections;
+	uint8_t num_clocks = ((2U << num_bits) < COUNTER_MAX_CLOCKS) ? (2U << num_bits) : COUNTER_MAX_CLOCKS;
+	uint8_t num_edges = 2U * num_clocks;
+	uint32_t in_mask = 0U;
+	uint32_t out_mask = 0U;
+	uint16_t settle_cycles = CheckerGetSettle(IC);
+	uint32_t cp_mask;
+	uint32_t mr_mask;
+	uint32_t expected;
+	uint32_t sample;
+	uint8_t count;
+	uint8_t step_base;
+	uint8_t index;
+
+	for(index = 0; index < IC->num_inputs; index++) in_mask |= SocketPinMask[IC->input_pins[index]];
+	for(index = 0; index < IC->num_outputs; index++) out_mask |= SocketPinMask[IC->output_pins[index]];
+
+	// Every section held in reset with its clock high
+	SOCKET_WRITE(in_mask, in_mask);
+	SocketSetOutputs(in_mask);
+	SocketSetInputs(out_mask);
+
+	for(uint8_t section = 0; section < num_sections; section++){
+		cp_mask = SocketPinMask[IC->input_pins[(section * COUNTER_PINS_SECTION) + COUNTER_PIN_CP]];
+		mr_mask = SocketPinMask[IC->input_pins[(section * COUNTER_PINS_SECTION) + COUNTER_PIN_MR]];
+		step_base = section * (1U + COUNTER_MAX_EDGES);
+
+		counterWait(settle_cycles);
+		*fail_step = step_base;
+		if(OcTripped() == TRUE) return FAILED;
+		if(SOCKET_READ() & out_mask) return FAILED;
+
+		SOCKET_WRITE(0U, mr_mask);
+		counterWait(settle_cycles);
+		if(counterRun(cp_mask, num_edges, settle_cycles) == FAILED) return FAILED;
+		SOCKET_WRITE(mr_mask, mr_mask);
+		if(OcTripped() == TRUE) return FAILED;
+
+		// Falling edges are the even samples, both samples of a clock hold
+		// its count
+		for(index = 0; index < num_edges; index++){
+			count = ((index >> 1) + 1U) & ((1U << num_bits) - 1U);
+			expected = 0U;
+			for(uint8_t bit = 0; bit < num_bits; bit++){
+				if(count & (1U << bit)) expected |= SocketPinMask[IC->output_pins[(section * num_bits) + bit]];
+			}
+
+			sample = ((uint32_t)counterSamplesB[index] << 16) | counterSamplesA[index];
+			*fail_step = step_base + 1U + index;
+			if((sample & out_mask) != expected) return FAILED;
+		}
+	}
+	return PASSED;
+}
+
+/******************************************************************************
+* counterRun - Private Function
+*
+* 08/12/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Sample phase passed in, edge period follows it.
+*
+* Description:  Generates clock edges on a socket pin every settle time
+* 				plus COUNTER_SAMPLE_MARGIN, first edge falling, with GPIOA
+* 				and GPIOB sampled the settle time after each edge. Runs
+* 				entirely on TIM1 and DMA1 channels 2-4, the CPU waits for
+* 				the sample transfers to complete.
+*
+* Arguments:    uint32_t cp_mask - Packed socket mask of clock pin
+*
+* 				uint8_t num_edges - Number of edges (and samples)
+*
+* 				uint16_t settle_cycles - SYSCLK cycles from each edge to
+* 				its sample
+*
+* Return:		PASSED, or FAILED if the DMA did not complete
+******************************************************************************/
+static uint8_t counterRun(uint32_t cp_mask, uint8_t num_edges, uint16_t settle_cycles)
+{
+	GPIO_TypeDef *cp_port = (cp_mask & 0xFFFFU) ? GPIOA : GPIOB;
+	uint32_t cp_bit = (cp_mask & 0xFFFFU) ? cp_mask : (cp_mask >> 16);
+	uint32_t edge_cycles = (uint32_t)settle_cycles + COUNTER_CLOCK_COMPARE + COUNTER_SAMPLE_MARGIN;
+	uint32_t timeout = (uint32_t)num_edges * edge_cycles;
+
+	counterClockWords[0] = cp_bit << 16;
+	counterClockWords[1] = cp_bit;
+
+	DMA1_Channel2->CCR = 0U;
+	DMA1_Channel2->CPAR = (uint32_t)&cp_port->BSRR;
+	DMA1_Channel2->CMAR = (uint32_t)counterClockWords;
+	DMA1_Channel2->CNDTR = 2U;
+	DMA1_Channel2->CCR = DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_DIR | DMA_CCR_EN;
+
+	DMA1_Channel3->CCR = 0U;
+	DMA1_Channel3->CPAR = (uint32_t)&GPIOA->IDR;
+	DMA1_Channel3->CMAR = (uint32_t)counterSamplesA;
+	DMA1_Channel3->CNDTR = num_edges;
+	DMA1_Channel3->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_EN;
+
+	DMA1_Channel4->CCR = 0U;
+	DMA1_Channel4->CPAR = (uint32_t)&GPIOB->IDR;
+	DMA1_Channel4->CMAR = (uint32_t)counterSamplesB;
+	DMA1_Channel4->CNDTR = num_edges;
+	DMA1_Channel4->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_EN;
+
+	DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3 | DMA_IFCR_CGIF4;
+
+	TIM1->CR1 = 0U;
+	TIM1->PSC = 0U;
+	TIM1->ARR = edge_cycles - 1U;
+	TIM1->CCR1 = COUNTER_CLOCK_COMPARE;
+	TIM1->CCR2 = COUNTER_CLOCK_COMPARE + settle_cycles;
+	TIM1->CCR4 = COUNTER_CLOCK_COMPARE + settle_cycles;
+	TIM1->CNT = 0U;
+	TIM1->SR = 0U;
+	TIM1->DIER = TIM_DIER_CC1DE | TIM_DIER_CC2DE | TIM_DIER_CC4DE;
+	TIM1->CR1 = TIM_CR1_CEN;
+
+	while(((DMA1->ISR & (DMA_ISR_TCIF3 | DMA_ISR_TCIF4)) != (DMA_ISR_TCIF3 | DMA_ISR_TCIF4)) && (timeout > 0U)){
+		timeout--;
+	}
+
+	TIM1->CR1 = 0U;
+	TIM1->DIER = 0U;
+	DMA1_Channel2->CCR = 0U;
+	DMA1_Channel3->CCR = 0U;
+	DMA1_Channel4->CCR = 0U;
+
+	return (timeout > 0U) ? PASSED : FAILED;
+}
+
+/******************************************************************************
+* counterWait - Private Function
+*
+* 08/12/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits the given number of SYSCLK cycles on the timestamp
+* 				counter.
+*
+* Arguments:    uint16_t cycles - Cycles to wait
+*
+* Return:		None
+******************************************************************************/
+static void counterWait(uint16_t cycles)
+{
+	uint16_t start = TIMESTAMP_NOW();
+
+	while((uint16_t)(TIMESTAMP_NOW() - start) < cycles){}
+}
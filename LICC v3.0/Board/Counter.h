@@ -0,0 +1,83 @@
+/******************************************************************************
+* 	Counter.h
+*
+* 	Header for Counter.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/12/2019:
+* 	Created hardware clocked binary counter test.
+*
+* 	08/31/2019:
+* 	Edge period and sample phase derived from the IC settle time.
+*
+* 	Created on: 08/12/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef COUNTER_H_
+#define COUNTER_H_
+
+#include "Checker.h"
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define COUNTER_PIN_CP 0U
+#define COUNTER_PIN_MR 1U
+// Roles of each pair of IC input_pins entries for IC_CLASS_COUNTER, one pair
+// per counter section: falling edge clock and active high master reset.
+// output_pins holds Q0 onwards of each section in turn.
+
+#define COUNTER_MAX_CLOCKS 32U
+// Most clock cycles applied to one section. Each section is clocked through
+// its full count twice (or up to this limit) so the wrap is checked too.
+
+#define COUNTER_MAX_EDGES (2U * COUNTER_MAX_CLOCKS)
+// One output sample is taken after every clock edge
+
+#define COUNTER_SAMPLE_MARGIN 12U
+// SYSCLK cycles from each output sample to the next clock edge, leaving time
+// for both sample transfers. Outputs are sampled the IC settle time after
+// each edge (see CheckerGetSettle), so clock edges are that plus this margin
+// apart (~5.3us, ~95kHz DUT clock, with the default settle time).
+
+/******************************************************************************
+* CounterInit - Public Function
+*
+* 08/12/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables clocks for TIM1 and DMA1, used to clock the DUT
+* 				and sample its outputs.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void CounterInit(void);
+
+/******************************************************************************
+* CounterTest - Public Function
+*
+* 08/12/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Edges spaced by the IC settle time.
+*
+* Description:  Tests each section of a binary counter IC. The section is
+* 				reset and checked, then clocked in hardware while its
+* 				outputs are sampled by DMA the IC settle time after every
+* 				edge. The captured sequence is checked against the
+* 				expected count once the run is complete.
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint8_t *fail_step - Failing step (section * (1 +
+* 				COUNTER_MAX_EDGES) + 0 for reset, + n for edge n)
+*
+* Return:		Test pass or test failure
+******************************************************************************/
+uint8_t CounterTest(const IC_PARAMETERS_T*, uint8_t*);
+
+#endif /* COUNTER_H_ */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* 	FailLog.c
+*
+* 	This source file keeps a log of the faults diagnosed on rejected ICs in
+* 	a reserved flash page, so that the vector order of each IC can adapt to
+* 	the defects actually seen in the parts stream across power cycles.
+* 	Records are appended into erased flash one halfword at a time, the page
+* 	is only erased once it is full.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/09/2019:
+* 	Created flash log of diagnosed faults.
+*
+* 	Created on: 08/09/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Flash.h"
+#include "FailLog.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define FAILLOG_EMPTY 0xFFFFU
+// Erased flash halfword
+
+#define FAILLOG_UNKNOWN_NEXT 0xFFFFU
+// Next free record not yet located
+
+#define FAILLOG ((const uint16_t *)FLASH_FAILLOG_PAGE)
+// Log records as stored in FLASH_FAILLOG_PAGE
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint16_t failLogNext = FAILLOG_UNKNOWN_NEXT;
+
+/******************************************************************************
+* FailLogRecord - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Appends a diagnosed fault to the log. The first free record
+* 				is located once after reset. When the log page is full it
+* 				is erased and the log restarts.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC the fault was found on
+*
+* 				uint16_t fault - Fault code
+*
+* Return:		None
+******************************************************************************/
+void FailLogRecord(IC_DESIGNATOR_T ic_designator, uint16_t fault)
+{
+	uint16_t record = ((uint16_t)ic_designator << 12) | (fault & 0x0FFFU);
+
+	if(failLogNext == FAILLOG_UNKNOWN_NEXT){
+		for(failLogNext = 0; failLogNext < FAILLOG_NUM_RECORDS; failLogNext++){
+			if(FAILLOG[failLogNext] == FAILLOG_EMPTY) break;
+		}
+	}
+
+	if(failLogNext >= FAILLOG_NUM_RECORDS){
+		if(FlashErasePage(FLASH_FAILLOG_PAGE) != FLASH_OK) return;
+		failLogNext = 0;
+	}
+
+	if(FlashProgram((uint32_t)&FAILLOG[failLogNext], &record, 1U) == FLASH_OK) failLogNext++;
+}
+
+/******************************************************************************
+* FailLogCount - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Counts how many times a fault has been logged for an IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to count for
+*
+* 				uint16_t fault - Fault code
+*
+* Return:		Number of matching records
+******************************************************************************/
+uint16_t FailLogCount(IC_DESIGNATOR_T ic_designator, uint16_t fault)
+{
+	uint16_t record = ((uint16_t)ic_designator << 12) | (fault & 0x0FFFU);
+	uint16_t count = 0U;
+
+	for(uint16_t index = 0; index < FAILLOG_NUM_RECORDS; index++){
+		if(FAILLOG[index] == FAILLOG_EMPTY) break;
+		if(FAILLOG[index] == record) count++;
+	}
+	return count;
+}
+
+/******************************************************************************
+* FailLogClear - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Erases every logged fault.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void FailLogClear(void)
+{
+	if(FlashErasePage(FLASH_FAILLOG_PAGE) == FLASH_OK) failLogNext = 0;
+}
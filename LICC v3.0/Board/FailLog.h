@@ -0,0 +1,75 @@
+/******************************************************************************
+* 	FailLog.h
+*
+* 	Header for FailLog.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/09/2019:
+* 	Created flash log of diagnosed faults.
+*
+* 	Created on: 08/09/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef FAILLOG_H_
+#define FAILLOG_H_
+
+#include "Flash.h"
+#include "Checker.h"
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define FAILLOG_NUM_RECORDS (FLASH_PAGE_SIZE / 2U)
+// One halfword record per diagnosed reject: IC designator in bits [15:12],
+// fault code (see FaultDict.h) in bits [11:0]. An erased record (0xFFFF)
+// marks the end of the log.
+
+/******************************************************************************
+* FailLogRecord - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Appends a diagnosed fault to the log. When the log page is
+* 				full it is erased and the log restarts.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC the fault was found on
+*
+* 				uint16_t fault - Fault code
+*
+* Return:		None
+******************************************************************************/
+void FailLogRecord(IC_DESIGNATOR_T, uint16_t);
+
+/******************************************************************************
+* FailLogCount - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Counts how many times a fault has been logged for an IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to count for
+*
+* 				uint16_t fault - Fault code
+*
+* Return:		Number of matching records
+******************************************************************************/
+uint16_t FailLogCount(IC_DESIGNATOR_T, uint16_t);
+
+/******************************************************************************
+* FailLogClear - Public Function
+*
+* 08/09/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Erases every logged fault.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void FailLogClear(void);
+
+#endif /* FAILLOG_H_ */
@@ -0,0 +1,300 @@
+/******************************************************************************
+* 	Family.c
+*
+* 	This source file tells apart HC, HCT and LS parts of the same function,
+* 	which all pass the logic test. The board has no DAC, so input thresholds
+* 	are found by RC ramping: an input driven to one level is released onto
+* 	the pull resistor towards the other, and the time until the gate output
+* 	switches is measured. The pull resistor and pin capacitance form the RC,
+* 	and as both edges share it the ratio of rise to fall time depends only
+* 	on the threshold as a fraction of VDD. TTL inputs source current, so
+* 	their falling ramp never reaches the threshold. Output high level is
+* 	read back by the ADC (see Parametric.c).
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/22/2019:
+* 	Created logic family discrimination (HC, HCT, LS).
+*
+* 	08/26/2019:
+* 	Open-drain ICs left unclassified.
+*
+* 	08/31/2019:
+* 	Ramp release made atomic against the over-current interrupt.
+*
+* 	Created on: 08/22/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "Parametric.h"
+#include "Family.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define FAMILY_RAMP_REPEATS 8U
+// Ramps summed per edge, the RC is only a few hundred ns
+
+#define FAMILY_RAMP_LIMIT 960U
+// Longest ramp (20us, ~50 time constants), longer ramps never switch
+
+#define FAMILY_RATIO_STEPS 13U
+#define FAMILY_RATIO_FIRST 200U
+#define FAMILY_RATIO_STEP 50U
+// Ratio table covers thresholds of 0.20 to 0.80 VDD
+
+#define FAMILY_RAMP_TIMEOUT 0xFFFFFFFFU
+#define FAMILY_NO_LEVELS 0xFFFFFFFFU
+
+/******************************************************************************
+* Private Constants
+******************************************************************************/
+static const uint16_t familyRatioTable[FAMILY_RATIO_STEPS] = {
+	35U, 53U, 76U, 105U, 143U, 192U, 256U, 342U, 459U, 624U, 864U, 1234U, 1847U
+};
+// Rise to fall time ratio (x256) of an RC ramp for a threshold of x VDD:
+// ln(1 - x) / ln(x), for x = 0.20, 0.25, ... 0.80
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static FAMILY_RESULT_T familyResult;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint32_t familySensitize(IC_PARAMETERS_T*, uint8_t, uint8_t);
+static uint32_t familyRamp(uint8_t, uint32_t, uint32_t, uint32_t);
+static uint16_t familyRatioToPermille(uint32_t);
+
+/******************************************************************************
+* FamilyClassify - Public Function
+*
+* 08/22/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/26/2019:	Anthony Needles
+* 				Open-drain ICs left unknown.
+*
+* Description:  Estimates the switching threshold of every input of a gate
+* 				IC and its output high level, and classifies its logic
+* 				family from them. Each input is ramped with the rest of
+* 				its gate set so the gate output follows it. Any input
+* 				sourcing current or an output high level a diode drop
+* 				under VDD is LS, otherwise the mean threshold tells HCT
+* 				from HC. Takes ~2ms for a quad gate. Open-drain outputs
+* 				rise through the pull-up, which would skew the rise to fall
+* 				ratio, so open-drain ICs stay unknown.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		Pointer to classification result
+******************************************************************************/
+const FAMILY_RESULT_T *FamilyClassify(IC_PARAMETERS_T *IC)
+{
+	PARAM_RESULT_T levels;
+	uint32_t in_mask = 0U;
+	uint32_t drive;
+	uint32_t rise;
+	uint32_t fall;
+	uint32_t permille_sum = 0U;
+	uint16_t permille;
+	uint8_t num_thresholds = 0U;
+	uint8_t gate_inputs;
+	uint8_t ic_pin;
+	uint8_t index;
+
+	familyResult.family = FAMILY_UNKNOWN;
+	familyResult.voh_mv = PARAM_NOT_MEASURED;
+	familyResult.threshold_permille = FAMILY_NO_THRESHOLD;
+	familyResult.ttl_input_pins = 0U;
+	for(ic_pin = 0; ic_pin <= SOCKET_NUM_PINS; ic_pin++) familyResult.threshold_mv[ic_pin] = FAMILY_NO_THRESHOLD;
+
+	if((IC->ic_class != IC_CLASS_GATE) || (IC->num_outputs == 0U)) return &familyResult;
+	if(IC->output_type == IC_OUTPUT_OPEN_DRAIN) return &familyResult;
+	gate_inputs = IC->num_inputs / IC->num_outputs;
+
+	// Output levels, loaded by the opposite pull
+	ParamMeasure(IC, &levels);
+	familyResult.vdd_mv = levels.vdd_mv;
+	for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(levels.voh_mv[ic_pin] < familyResult.voh_mv) familyResult.voh_mv = levels.voh_mv[ic_pin];
+	}
+
+	for(index = 0; index < IC->num_inputs; index++) in_mask |= SocketPinMask[IC->input_pins[index]];
+	SOCKET_WRITE(0U, in_mask);
+	SocketSetOutputs(in_mask);
+
+	for(index = 0; index < IC->num_inputs; index++){
+		ic_pin = IC->input_pins[index];
+		drive = familySensitize(IC, index / gate_inputs, index);
+		if(drive == FAMILY_NO_LEVELS) continue;
+
+		rise = familyRamp(ic_pin, drive, in_mask, SocketPinMask[IC->output_pins[index / gate_inputs]]);
+		fall = familyRamp(ic_pin, drive | SocketPinMask[ic_pin], in_mask, SocketPinMask[IC->output_pins[index / gate_inputs]]);
+
+		if(fall == FAMILY_RAMP_TIMEOUT){
+			familyResult.ttl_input_pins |= (1U << ic_pin);
+		}
+		else if((rise != FAMILY_RAMP_TIMEOUT) && (fall != 0U)){
+			permille = familyRatioToPermille((rise << 8) / fall);
+			familyResult.threshold_mv[ic_pin] = ((uint32_t)permille * familyResult.vdd_mv) / 1000U;
+			permille_sum += permille;
+			num_thresholds++;
+		}
+	}
+
+	SocketFloat();
+
+	if(num_thresholds != 0U) familyResult.threshold_permille = permille_sum / num_thresholds;
+
+	if((familyResult.ttl_input_pins != 0U)
+	   || ((familyResult.voh_mv != PARAM_NOT_MEASURED)
+		   && (((uint32_t)familyResult.voh_mv + FAMILY_LS_VOH_DROP_MV) < familyResult.vdd_mv))){
+		familyResult.family = FAMILY_LS;
+	}
+	else if(num_thresholds != 0U){
+		familyResult.family = (familyResult.threshold_permille < FAMILY_HCT_MAX_PERMILLE) ? FAMILY_HCT : FAMILY_HC;
+	}
+
+	return &familyResult;
+}
+
+/******************************************************************************
+* familySensitize - Private Function
+*
+* 08/22/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds levels for the other inputs of a gate under which the
+* 				gate output follows the given input. Inputs of other gates
+* 				are held low.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint8_t gate - Gate number
+*
+* 				uint8_t input - Index of the input in IC->input_pins
+*
+* Return:		Packed socket word of input levels with the given input
+* 				low, FAMILY_NO_LEVELS if no levels sensitize it
+******************************************************************************/
+static uint32_t familySensitize(IC_PARAMETERS_T *IC, uint8_t gate, uint8_t input)
+{
+	uint8_t gate_inputs = IC->num_inputs / IC->num_outputs;
+	uint8_t first = gate * gate_inputs;
+	uint32_t out_mask = SocketPinMask[IC->output_pins[gate]];
+	uint32_t in_mask = SocketPinMask[IC->input_pins[input]];
+	uint32_t drive;
+
+	for(uint8_t levels = 0; levels < (1U << gate_inputs); levels++){
+		drive = 0U;
+		for(uint8_t bit = 0; bit < gate_inputs; bit++){
+			if((levels & (1U << bit)) && ((first + bit) != input)) drive |= SocketPinMask[IC->input_pins[first + bit]];
+		}
+		if((CheckerEvaluate(IC, drive) ^ CheckerEvaluate(IC, drive | in_mask)) & out_mask) return drive;
+	}
+	return FAMILY_NO_LEVELS;
+}
+
+/******************************************************************************
+* familyRamp - Private Function
+*
+* 08/22/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Release guarded by SOCKET_MODE_LOCK.
+*
+* Description:  Drives the inputs, then releases one input onto the pull
+* 				resistor towards the opposite level and times how long the
+* 				gate output takes to switch. The input is released by a
+* 				single mode register write so every ramp starts the same
+* 				number of cycles after the timestamp. The over-current
+* 				interrupt is masked from before the timestamp until just
+* 				after the release (see SOCKET_MODE_LOCK), which adds the
+* 				same few cycles to both ramp directions.
+*
+* Arguments:    uint8_t ic_pin - IC pin of input ramped
+*
+* 				uint32_t drive - Packed socket word of input levels before
+* 				the ramp
+*
+* 				uint32_t in_mask - Packed socket mask of IC inputs
+*
+* 				uint32_t out_mask - Packed socket mask of gate output
+*
+* Return:		SYSCLK cycles summed over FAMILY_RAMP_REPEATS ramps,
+* 				FAMILY_RAMP_TIMEOUT if the output did not switch
+******************************************************************************/
+static uint32_t familyRamp(uint8_t ic_pin, uint32_t drive, uint32_t in_mask, uint32_t out_mask)
+{
+	uint32_t pin_mask = SocketPinMask[ic_pin];
+	uint32_t total = 0U;
+	uint32_t before;
+	uint16_t start;
+	uint16_t elapsed;
+	uint32_t oc_enable;
+	uint8_t bit;
+	GPIO_TypeDef *port = SocketPinPort(ic_pin, &bit);
+
+	if(port == 0) return FAMILY_RAMP_TIMEOUT;
+	SocketSetPull(pin_mask, (drive & pin_mask) ? SOCKET_PULL_DOWN : SOCKET_PULL_UP);
+
+	for(uint8_t repeat = 0; repeat < FAMILY_RAMP_REPEATS; repeat++){
+		SOCKET_WRITE(drive, in_mask);
+		SocketSetOutputs(pin_mask);
+		start = TIMESTAMP_NOW();
+		while((uint16_t)(TIMESTAMP_NOW() - start) < CYCLES_DELAY){}
+		before = SOCKET_READ() & out_mask;
+
+		SOCKET_MODE_LOCK(oc_enable);
+		start = TIMESTAMP_NOW();
+		port->MODER &= ~(3U << (2U * bit));
+		SOCKET_MODE_UNLOCK(oc_enable);
+		do{
+			elapsed = (uint16_t)(TIMESTAMP_NOW() - start);
+		} while(((SOCKET_READ() & out_mask) == before) && (elapsed < FAMILY_RAMP_LIMIT));
+
+		if(elapsed >= FAMILY_RAMP_LIMIT){
+			total = FAMILY_RAMP_TIMEOUT;
+			break;
+		}
+		total += elapsed;
+	}
+
+	SocketSetOutputs(pin_mask);
+	SocketSetPull(pin_mask, SOCKET_PULL_NONE);
+	return total;
+}
+
+/******************************************************************************
+* familyRatioToPermille - Private Function
+*
+* 08/22/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a rise to fall time ratio into the input threshold
+* 				as a fraction of VDD, interpolating familyRatioTable.
+*
+* Arguments:    uint32_t ratio - Rise time / fall time, x256
+*
+* Return:		Threshold in per mille of VDD
+******************************************************************************/
+static uint16_t familyRatioToPermille(uint32_t ratio)
+{
+	uint8_t step;
+
+	if(ratio <= familyRatioTable[0]) return FAMILY_RATIO_FIRST;
+	for(step = 1; step < FAMILY_RATIO_STEPS; step++){
+		if(ratio <= familyRatioTable[step]) break;
+	}
+	if(step == FAMILY_RATIO_STEPS) return FAMILY_RATIO_FIRST + ((FAMILY_RATIO_STEPS - 1U) * FAMILY_RATIO_STEP);
+
+	return FAMILY_RATIO_FIRST + ((step - 1U) * FAMILY_RATIO_STEP)
+		   + (((ratio - familyRatioTable[step - 1U]) * FAMILY_RATIO_STEP)
+			  / (familyRatioTable[step] - familyRatioTable[step - 1U]));
+}
@@ -0,0 +1,66 @@
+/******************************************************************************
+* 	Family.h
+*
+* 	Header for Family.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/22/2019:
+* 	Created logic family discrimination (HC, HCT, LS).
+*
+* 	Created on: 08/22/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef FAMILY_H_
+#define FAMILY_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+typedef enum {FAMILY_UNKNOWN,
+			  FAMILY_HC,
+			  FAMILY_HCT,
+			  FAMILY_LS
+} FAMILY_T;
+// Logic family a gate IC was classified as
+
+#define FAMILY_HCT_MAX_PERMILLE 440U
+// Input thresholds below this fraction of VDD (per mille) are TTL level
+// (HCT, ~1.4V at 5V, lower at 3.3V), above are CMOS level (HC, ~VDD / 2)
+
+#define FAMILY_LS_VOH_DROP_MV 700U
+// Bipolar totem pole outputs stay more than a diode drop under VDD
+
+#define FAMILY_NO_THRESHOLD 0xFFFFU
+// Threshold of an input that is not an IC input or could not be measured
+
+typedef struct {
+	FAMILY_T family;
+	uint16_t vdd_mv;
+	uint16_t voh_mv;
+	uint16_t threshold_permille;
+	uint16_t ttl_input_pins;
+	uint16_t threshold_mv[SOCKET_NUM_PINS + 1];
+} FAMILY_RESULT_T;
+// Result of a family classification: family, supply voltage, lowest output
+// high level, mean input threshold as a fraction of VDD, inputs sourcing
+// current like TTL inputs (bit n = IC pin n), and the threshold of each
+// input, indexed by IC pin
+
+/******************************************************************************
+* FamilyClassify - Public Function
+*
+* 08/22/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Estimates the switching threshold of every input of a gate
+* 				IC and its output high level, and classifies its logic
+* 				family from them. Takes ~2ms for a quad gate.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		Pointer to classification result
+******************************************************************************/
+const FAMILY_RESULT_T *FamilyClassify(IC_PARAMETERS_T*);
+
+#endif /* FAMILY_H_ */
@@ -0,0 +1,409 @@
+/******************************************************************************
+* 	FaultDict.c
+*
+* 	This source file names the likely physical defect of a rejected IC. For
+* 	each IC the compiled vector program is run against models of the IC
+* 	carrying a stuck-low or stuck-high fault on every used pin and a bridge
+* 	between every pair of adjacent used pins. The failing vector set of each
+* 	fault is hashed with the CRC unit and kept in a sorted table, so that the
+* 	failing vector set of a rejected IC is diagnosed with a binary search.
+* 	Open outputs cannot be told apart from stuck outputs by logic levels
+* 	alone and are instead detected by the checker with the MCU pulls.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/08/2019:
+* 	Created fault dictionary for diagnosing rejected ICs.
+*
+* 	Created on: 08/08/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "FaultDict.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint32_t faultDictKey[FAULT_DICT_SIZE];
+static uint16_t faultDictFault[FAULT_DICT_SIZE];
+static uint8_t faultDictCount = 0U;
+static uint8_t faultDictValid = 0U;
+static IC_DESIGNATOR_T faultDictDesignator;
+// Dictionary of the last IC diagnosed, keys in ascending order with the
+// fault code of each key at the same index
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static void faultDictBuild(IC_PARAMETERS_T*);
+static void faultDictInsert(uint64_t, uint16_t);
+static uint32_t faultDictHash(uint64_t);
+static uint8_t faultDictAppend(char*, uint8_t, const char*);
+static uint8_t faultDictAppendPin(char*, uint8_t, uint8_t);
+
+/******************************************************************************
+* FaultDictInvalidate - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Discards the cached dictionary. Called whenever the checker
+* 				compiles a new vector program.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void FaultDictInvalidate(void)
+{
+	faultDictValid = 0U;
+}
+
+/******************************************************************************
+* FaultDictSimulate - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Runs the compiled vector program of the IC against a model
+* 				of the IC carrying the given fault and returns the vectors
+* 				that would fail. Input levels are tracked across vectors the
+* 				same way the checker drives them. A stuck input is seen by
+* 				the die at the stuck level, a stuck output reads at the stuck
+* 				level. Two bridged inputs or two bridged outputs are modeled
+* 				as a wired-AND (a low driver wins), an input bridged to an
+* 				output reads the level the checker drives on the input.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint16_t fault - Fault code to inject
+*
+* Return:		Failing vector set (bit n = vector n)
+******************************************************************************/
+uint64_t FaultDictSimulate(IC_PARAMETERS_T *IC, uint16_t fault)
+{
+	const CHECKER_PROGRAM_T *program = CheckerGetProgram(IC);
+	const CHECKER_VECTOR_T *vector;
+	uint32_t mask_a = (FAULT_PIN_A(fault) <= SOCKET_NUM_PINS) ? SocketPinMask[FAULT_PIN_A(fault)] : 0U;
+	uint32_t mask_b = (FAULT_PIN_B(fault) <= SOCKET_NUM_PINS) ? SocketPinMask[FAULT_PIN_B(fault)] : 0U;
+	uint32_t mask_ab = mask_a | mask_b;
+	uint32_t levels = 0U;
+	uint32_t seen;
+	uint32_t outputs;
+	uint64_t fail_set = 0U;
+
+	for(uint8_t index = 0; index < program->num_vectors; index++){
+		vector = &program->vectors[index];
+		levels = (levels & ~vector->drive_mask) | (vector->drive & vector->drive_mask);
+
+		// Input levels as seen by the die
+		seen = levels;
+		switch(FAULT_TYPE(fault)){
+		case FAULT_STUCK_LOW:
+			seen &= ~mask_a;
+			break;
+
+		case FAULT_STUCK_HIGH:
+			seen |= mask_a;
+			break;
+
+		case FAULT_BRIDGE:
+			if(((mask_ab & program->in_mask) == mask_ab) && ((seen & mask_ab) != mask_ab)) seen &= ~mask_ab;
+			break;
+
+		default:
+			break;
+		}
+
+		// Output levels as read by the checker
+		outputs = CheckerEvaluate(IC, seen);
+		switch(FAULT_TYPE(fault)){
+		case FAULT_STUCK_LOW:
+			outputs &= ~mask_a;
+			break;
+
+		case FAULT_STUCK_HIGH:
+			outputs |= mask_a;
+			break;
+
+		case FAULT_BRIDGE:
+			if((mask_ab & program->out_mask) == mask_ab){
+				if((outputs & mask_ab) != mask_ab) outputs &= ~mask_ab;
+			}
+			else if(mask_a & program->out_mask){
+				outputs = (outputs & ~mask_a) | ((seen & mask_b) ? mask_a : 0U);
+			}
+			else if(mask_b & program->out_mask){
+				outputs = (outputs & ~mask_b) | ((seen & mask_a) ? mask_b : 0U);
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		if((outputs ^ vector->expect) & vector->care) fail_set |= ((uint64_t)1U << index);
+	}
+	return fail_set;
+}
+
+/******************************************************************************
+* FaultDictLookup - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Names the most likely defect of a rejected IC. Open outputs
+* 				are reported directly. Otherwise the failing vector set is
+* 				hashed and binary searched in the dictionary of the IC,
+* 				which is built on the first lookup after a program change.
+* 				Faults that fail the exact same vectors cannot be told apart,
+* 				the first one added (stuck-at before bridges) is returned
+* 				along with how many matched.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint64_t fail_set - Failing vector set (bit n = vector n)
+*
+* 				uint16_t open_pins - Open output IC pins (bit n = IC pin n)
+*
+* 				uint8_t *num_candidates - Number of equally likely faults
+*
+* Return:		Fault code (FAULT_UNKNOWN if no entry matches)
+******************************************************************************/
+uint16_t FaultDictLookup(IC_PARAMETERS_T *IC, uint64_t fail_set, uint16_t open_pins, uint8_t *num_candidates)
+{
+	uint32_t key;
+	uint8_t low = 0U;
+	uint8_t high;
+	uint8_t mid;
+	uint8_t match;
+
+	*num_candidates = 0U;
+
+	if(open_pins != 0U){
+		uint16_t fault = FAULT_UNKNOWN;
+		for(uint8_t ic_pin = SOCKET_NUM_PINS; ic_pin > 0; ic_pin--){
+			if(open_pins & (1U << ic_pin)){
+				fault = FAULT_CODE(FAULT_OPEN, ic_pin, 0U);
+				(*num_candidates)++;
+			}
+		}
+		return fault;
+	}
+
+	if(fail_set == 0U) return FAULT_UNKNOWN;
+
+	if((faultDictValid != TRUE) || (faultDictDesignator != IC->ic_designator)){
+		faultDictBuild(IC);
+	}
+
+	// Lower bound binary search, lands on first of any equal keys
+	key = faultDictHash(fail_set);
+	high = faultDictCount;
+	while(low < high){
+		mid = (low + high) >> 1;
+		if(faultDictKey[mid] < key) low = mid + 1U;
+		else high = mid;
+	}
+
+	for(match = low; (match < faultDictCount) && (faultDictKey[match] == key); match++);
+	if(match == low) return FAULT_UNKNOWN;
+
+	*num_candidates = match - low;
+	return faultDictFault[low];
+}
+
+/******************************************************************************
+* FaultDictDescribe - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Writes a readable description of a fault code, such as
+* 				"pin 9 stuck-low" or "pins 12-13 bridged".
+*
+* Arguments:    uint16_t fault - Fault code
+*
+* 				char *text - Buffer of at least FAULT_DESCRIBE_LEN chars
+*
+* Return:		Length of description (excluding terminator)
+******************************************************************************/
+uint8_t FaultDictDescribe(uint16_t fault, char *text)
+{
+	uint8_t len = 0U;
+
+	switch(FAULT_TYPE(fault)){
+	case FAULT_NONE:
+		len = faultDictAppend(text, len, "none");
+		break;
+
+	case FAULT_STUCK_LOW:
+	case FAULT_STUCK_HIGH:
+	case FAULT_OPEN:
+		len = faultDictAppend(text, len, "pin ");
+		len = faultDictAppendPin(text, len, FAULT_PIN_A(fault));
+		len = faultDictAppend(text, len, (FAULT_TYPE(fault) == FAULT_STUCK_LOW) ? " stuck-low" :
+										 (FAULT_TYPE(fault) == FAULT_STUCK_HIGH) ? " stuck-high" : " open");
+		break;
+
+	case FAULT_BRIDGE:
+		len = faultDictAppend(text, len, "pins ");
+		len = faultDictAppendPin(text, len, FAULT_PIN_A(fault));
+		len = faultDictAppend(text, len, "-");
+		len = faultDictAppendPin(text, len, FAULT_PIN_B(fault));
+		len = faultDictAppend(text, len, " bridged");
+		break;
+
+	default:
+		len = faultDictAppend(text, len, "unknown");
+		break;
+	}
+
+	text[len] = '\0';
+	return len;
+}
+
+/******************************************************************************
+* faultDictBuild - Private Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Simulates every fault of the IC and adds the detectable
+* 				ones to the dictionary. Faults are added stuck-at first as
+* 				they are the more common defect.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* Return:		None
+******************************************************************************/
+static void faultDictBuild(IC_PARAMETERS_T *IC)
+{
+	const CHECKER_PROGRAM_T *program = CheckerGetProgram(IC);
+	uint32_t used_mask = program->in_mask | program->out_mask;
+	uint8_t ic_pin;
+
+	faultDictCount = 0U;
+
+	for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if((SocketPinMask[ic_pin] & used_mask) == 0U) continue;
+		faultDictInsert(FaultDictSimulate(IC, FAULT_CODE(FAULT_STUCK_LOW, ic_pin, 0U)), FAULT_CODE(FAULT_STUCK_LOW, ic_pin, 0U));
+		faultDictInsert(FaultDictSimulate(IC, FAULT_CODE(FAULT_STUCK_HIGH, ic_pin, 0U)), FAULT_CODE(FAULT_STUCK_HIGH, ic_pin, 0U));
+	}
+
+	// Adjacent pins only, GND and VCC are never bridged to a socket pin
+	for(ic_pin = 1; ic_pin < SOCKET_NUM_PINS; ic_pin++){
+		if(((SocketPinMask[ic_pin] & used_mask) == 0U) || ((SocketPinMask[ic_pin + 1] & used_mask) == 0U)) continue;
+		faultDictInsert(FaultDictSimulate(IC, FAULT_CODE(FAULT_BRIDGE, ic_pin, ic_pin + 1U)), FAULT_CODE(FAULT_BRIDGE, ic_pin, ic_pin + 1U));
+	}
+
+	faultDictDesignator = IC->ic_designator;
+	faultDictValid = TRUE;
+}
+
+/******************************************************************************
+* faultDictInsert - Private Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Adds a fault to the dictionary keeping keys in ascending
+* 				order. Equal keys stay in the order they were added.
+* 				Undetectable faults (empty failing vector set) are dropped.
+*
+* Arguments:    uint64_t fail_set - Failing vector set of the fault
+*
+* 				uint16_t fault - Fault code
+*
+* Return:		None
+******************************************************************************/
+static void faultDictInsert(uint64_t fail_set, uint16_t fault)
+{
+	uint32_t key;
+	uint8_t index;
+
+	if((fail_set == 0U) || (faultDictCount >= FAULT_DICT_SIZE)) return;
+
+	key = faultDictHash(fail_set);
+	for(index = faultDictCount; (index > 0) && (faultDictKey[index - 1] > key); index--){
+		faultDictKey[index] = faultDictKey[index - 1];
+		faultDictFault[index] = faultDictFault[index - 1];
+	}
+	faultDictKey[index] = key;
+	faultDictFault[index] = fault;
+	faultDictCount++;
+}
+
+/******************************************************************************
+* faultDictHash - Private Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Hashes a failing vector set with the CRC unit.
+*
+* Arguments:    uint64_t fail_set - Failing vector set
+*
+* Return:		32-bit key
+******************************************************************************/
+static uint32_t faultDictHash(uint64_t fail_set)
+{
+	CRC->CR = CRC_CR_RESET;
+	CRC->DR = (uint32_t)fail_set;
+	CRC->DR = (uint32_t)(fail_set >> 32);
+	return CRC->DR;
+}
+
+/******************************************************************************
+* faultDictAppend - Private Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Copies a string onto the end of the description.
+*
+* Arguments:    char *text - Description buffer
+*
+* 				uint8_t len - Current description length
+*
+* 				const char *str - String to append
+*
+* Return:		New description length
+******************************************************************************/
+static uint8_t faultDictAppend(char *text, uint8_t len, const char *str)
+{
+	while((*str != '\0') && (len < (FAULT_DESCRIBE_LEN - 1))) text[len++] = *str++;
+	return len;
+}
+
+/******************************************************************************
+* faultDictAppendPin - Private Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Writes an IC pin number (1-14) onto the end of the
+* 				description.
+*
+* Arguments:    char *text - Description buffer
+*
+* 				uint8_t len - Current description length
+*
+* 				uint8_t ic_pin - IC pin number
+*
+* Return:		New description length
+******************************************************************************/
+static uint8_t faultDictAppendPin(char *text, uint8_t len, uint8_t ic_pin)
+{
+	if((ic_pin >= 10) && (len < (FAULT_DESCRIBE_LEN - 1))) text[len++] = '0' + (ic_pin / 10);
+	if(len < (FAULT_DESCRIBE_LEN - 1)) text[len++] = '0' + (ic_pin % 10);
+	return len;
+}
@@ -0,0 +1,117 @@
+/******************************************************************************
+* 	FaultDict.h
+*
+* 	Header for FaultDict.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/08/2019:
+* 	Created fault dictionary for diagnosing rejected ICs.
+*
+* 	Created on: 08/08/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef FAULTDICT_H_
+#define FAULTDICT_H_
+
+#include "Checker.h"
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define FAULT_NONE 0x0000U
+#define FAULT_STUCK_LOW 0x0100U
+#define FAULT_STUCK_HIGH 0x0200U
+#define FAULT_BRIDGE 0x0300U
+#define FAULT_OPEN 0x0400U
+#define FAULT_UNKNOWN 0x0F00U
+// Fault types. A fault code is the type in bits [11:8], the IC pin in bits
+// [7:4] and the second IC pin of a bridge in bits [3:0]
+
+#define FAULT_TYPE(fault) ((fault) & 0x0F00U)
+#define FAULT_PIN_A(fault) (((fault) >> 4) & 0x0FU)
+#define FAULT_PIN_B(fault) ((fault) & 0x0FU)
+#define FAULT_CODE(type, pin_a, pin_b) ((type) | ((pin_a) << 4) | (pin_b))
+// Fault code field access
+
+#define FAULT_DICT_SIZE 40U
+// Largest dictionary, SA0 and SA1 on 12 IC pins plus 10 adjacent bridges
+// with room to spare
+
+#define FAULT_DESCRIBE_LEN 20U
+// Buffer length required by FaultDictDescribe, including terminator
+
+/******************************************************************************
+* FaultDictInvalidate - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Discards the cached dictionary. Called whenever the checker
+* 				compiles a new vector program.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void FaultDictInvalidate(void);
+
+/******************************************************************************
+* FaultDictSimulate - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Runs the compiled vector program of the IC against a model
+* 				of the IC carrying the given fault and returns the vectors
+* 				that would fail.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint16_t fault - Fault code to inject
+*
+* Return:		Failing vector set (bit n = vector n)
+******************************************************************************/
+uint64_t FaultDictSimulate(IC_PARAMETERS_T*, uint16_t);
+
+/******************************************************************************
+* FaultDictLookup - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Names the most likely defect of a rejected IC. Open outputs
+* 				are reported directly. Otherwise the failing vector set is
+* 				hashed and binary searched in the dictionary of the IC,
+* 				which is built on the first lookup after a program change.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint64_t fail_set - Failing vector set (bit n = vector n)
+*
+* 				uint16_t open_pins - Open output IC pins (bit n = IC pin n)
+*
+* 				uint8_t *num_candidates - Number of equally likely faults
+*
+* Return:		Fault code (FAULT_UNKNOWN if no entry matches)
+******************************************************************************/
+uint16_t FaultDictLookup(IC_PARAMETERS_T*, uint64_t, uint16_t, uint8_t*);
+
+/******************************************************************************
+* FaultDictDescribe - Public Function
+*
+* 08/08/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Writes a readable description of a fault code, such as
+* 				"pin 9 stuck-low" or "pins 12-13 bridged".
+*
+* Arguments:    uint16_t fault - Fault code
+*
+* 				char *text - Buffer of at least FAULT_DESCRIBE_LEN chars
+*
+* Return:		Length of description (excluding terminator)
+******************************************************************************/
+uint8_t FaultDictDescribe(uint16_t, char*);
+
+#endif /* FAULTDICT_H_ */
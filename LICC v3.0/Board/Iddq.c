@@ -0,0 +1,137 @@
+/******************************************************************************
+* 	Iddq.c
+*
+* 	This source file screens ICs for excess quiescent supply current, which
+* 	damaged CMOS parts often draw while still passing every logic test. The
+* 	socket VCC current sense amplifier output is on spare pin PA0 (ADC_IN0).
+* 	One sample per vector is started by the test loop just before the end
+* 	of the settle window it already waits in and moved to RAM by DMA, so
+* 	screening adds almost no test time.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/23/2019:
+* 	Created quiescent supply current (IDDQ) screening.
+*
+* 	Created on: 08/23/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Adc.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "Iddq.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define FAILED 0U
+
+#define IDDQ_PIN 0U
+// Current sense input pin of port A
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint16_t iddqSamples[CHECKER_MAX_VECTORS];
+static uint16_t iddqLimit[CHECKER_NUM_DESIGNATORS];
+static uint16_t iddqVddaMv;
+
+/******************************************************************************
+* IddqInit - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the current sense pin (PA0) to analog mode and every
+* 				IC limit to IDDQ_DEFAULT_LIMIT_UA.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void IddqInit(void)
+{
+	RCC->AHBENR |= RCC_AHBENR_GPIOAEN;
+	GPIOA->MODER |= (3U << (2U * IDDQ_PIN));
+
+	for(uint8_t index = 0; index < CHECKER_NUM_DESIGNATORS; index++) iddqLimit[index] = IDDQ_DEFAULT_LIMIT_UA;
+}
+
+/******************************************************************************
+* IddqSetLimit - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the supply current limit of an IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to set the limit of
+*
+* 				uint16_t limit_ua - Limit in uA
+*
+* Return:		None
+******************************************************************************/
+void IddqSetLimit(IC_DESIGNATOR_T ic_designator, uint16_t limit_ua)
+{
+	iddqLimit[ic_designator % CHECKER_NUM_DESIGNATORS] = limit_ua;
+}
+
+/******************************************************************************
+* IddqStart - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Measures VDDA, then sets up a conversion stream of the
+* 				current sense channel with one sample per vector. Samples
+* 				are started by IDDQ_SAMPLE() from the test loop.
+*
+* Arguments:    uint8_t num_vectors - Most vectors sampled
+*
+* Return:		None
+******************************************************************************/
+void IddqStart(uint8_t num_vectors)
+{
+	uint16_t vrefint;
+
+	AdcScan(1UL << ADC_CHANNEL_VREFINT, &vrefint);
+	iddqVddaMv = AdcVddaMv(vrefint);
+
+	if(num_vectors > CHECKER_MAX_VECTORS) num_vectors = CHECKER_MAX_VECTORS;
+	AdcStreamStart(IDDQ_CHANNEL, iddqSamples, num_vectors);
+}
+
+/******************************************************************************
+* IddqFinish - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Ends the sample stream, finds the vector drawing the most
+* 				current and compares it against the IC limit.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC tested
+*
+* 				uint16_t *worst_ua - Returns the highest current (uA)
+*
+* 				uint8_t *worst_vector - Returns the vector drawing it
+*
+* Return:		PASSED if every sample is within the limit
+******************************************************************************/
+uint8_t IddqFinish(IC_DESIGNATOR_T ic_designator, uint16_t *worst_ua, uint8_t *worst_vector)
+{
+	uint16_t num_samples = AdcStreamStop();
+	uint16_t worst = 0U;
+
+	*worst_vector = IDDQ_NO_VECTOR;
+	for(uint8_t index = 0; index < num_samples; index++){
+		if((*worst_vector == IDDQ_NO_VECTOR) || (iddqSamples[index] > worst)){
+			worst = iddqSamples[index];
+			*worst_vector = index;
+		}
+	}
+
+	*worst_ua = ((uint32_t)ADC_TO_MV(worst, iddqVddaMv) * 1000U) / IDDQ_SENSE_UV_PER_UA;
+	return (*worst_ua > iddqLimit[ic_designator % CHECKER_NUM_DESIGNATORS]) ? FAILED : PASSED;
+}
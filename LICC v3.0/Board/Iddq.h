@@ -0,0 +1,110 @@
+/******************************************************************************
+* 	Iddq.h
+*
+* 	Header for Iddq.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/23/2019:
+* 	Created quiescent supply current (IDDQ) screening.
+*
+* 	08/24/2019:
+* 	Current sense channel and gain made public for over-current shutdown.
+*
+* 	Created on: 08/23/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef IDDQ_H_
+#define IDDQ_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define IDDQ_CHANNEL 0U
+// Socket supply current sense input, PA0 (ADC_IN0)
+
+#define IDDQ_SENSE_UV_PER_UA 1000U
+// Current sense gain, 1mV out per uA of socket supply current (full scale
+// ~3.3mA)
+
+#define IDDQ_DEFAULT_LIMIT_UA 20U
+// 74HC quiescent supply current limit of an SSI part over temperature
+
+#define IDDQ_LEAD_CYCLES (ADC_STREAM_SAMPLE_CYCLES + 18U)
+// Sample is started this many SYSCLK cycles before the end of the settle
+// window, so sampling ends as the outputs are read (includes the ADC start
+// latency)
+
+#define IDDQ_NO_VECTOR 0xFFU
+// Worst vector when no sample was taken
+
+/******************************************************************************
+* IddqInit - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the current sense pin (PA0) to analog mode and every
+* 				IC limit to IDDQ_DEFAULT_LIMIT_UA.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void IddqInit(void);
+
+/******************************************************************************
+* IddqSetLimit - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the supply current limit of an IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC to set the limit of
+*
+* 				uint16_t limit_ua - Limit in uA
+*
+* Return:		None
+******************************************************************************/
+void IddqSetLimit(IC_DESIGNATOR_T, uint16_t);
+
+/******************************************************************************
+* IddqStart - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Measures VDDA, then sets up a conversion stream of the
+* 				current sense channel with one sample per vector. Samples
+* 				are started by IDDQ_SAMPLE() from the test loop.
+*
+* Arguments:    uint8_t num_vectors - Most vectors sampled
+*
+* Return:		None
+******************************************************************************/
+void IddqStart(uint8_t);
+
+#define IDDQ_SAMPLE() ADC_START()
+// Samples supply current of the vector applied, results are moved by DMA
+
+/******************************************************************************
+* IddqFinish - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Ends the sample stream, finds the vector drawing the most
+* 				current and compares it against the IC limit.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC tested
+*
+* 				uint16_t *worst_ua - Returns the highest current (uA)
+*
+* 				uint8_t *worst_vector - Returns the vector drawing it
+*
+* Return:		PASSED if every sample is within the limit
+******************************************************************************/
+uint8_t IddqFinish(IC_DESIGNATOR_T, uint16_t*, uint8_t*);
+
+#endif /* IDDQ_H_ */
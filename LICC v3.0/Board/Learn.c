@@ -0,0 +1,422 @@
+/******************************************************************************
+* 	Learn.c
+*
+* 	This source file identifies unmarked 14 pin combinational ICs. Each
+* 	socket pin is classed as an IC output if it ever disagrees with the MCU
+* 	pull applied to it, otherwise as an input (unconnected pins class as
+* 	inputs, which do not affect any output). Every input combination is
+* 	then applied in Gray code order, so a single pin changes per step, and
+* 	the outputs are captured with port-wide reads into a truth table. The
+* 	CRC of the pin directions and truth table is a canonical signature, as
+* 	a part always sits in the socket the same way round. Library ICs get
+* 	their signature from the same truth table built from their failure
+* 	functions, and are kept in a small open addressed hash index.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/13/2019:
+* 	Created black-box truth table learning and library matching.
+*
+* 	Created on: 08/13/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "SysTick.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "Learn.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+
+#define LEARN_MAX_PINS 12U
+// Socket pins routed to the MCU
+
+#define LEARN_EMPTY_SLOT 0xFFU
+// Unused hash index slot
+
+/******************************************************************************
+* Private Constants
+******************************************************************************/
+static const IC_PARAMETERS_T * const learnLibrary[] = {
+	&IC_74HC00_PARAM,
+	&IC_74HC02_PARAM,
+	&IC_74HC04_PARAM,
+	&IC_74HC08_PARAM,
+	&IC_74HC10_PARAM,
+	&IC_74HC20_PARAM,
+	&IC_74HC27_PARAM,
+	&IC_74HC86_PARAM
+};
+// Combinational library ICs that can be learned
+
+#define LEARN_LIBRARY_SIZE (sizeof(learnLibrary) / sizeof(learnLibrary[0]))
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static LEARN_RESULT_T learnResult;
+static uint32_t learnTable[LEARN_TABLE_WORDS];
+static uint32_t learnIndexKey[LEARN_INDEX_SIZE];
+static uint8_t learnIndexDesignator[LEARN_INDEX_SIZE];
+static uint8_t learnIndexValid = 0U;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint16_t learnFindOutputs(void);
+static uint8_t learnPinMasks(uint16_t, uint32_t*);
+static uint32_t learnSignature(uint16_t, uint16_t);
+static void learnBuildIndex(void);
+static uint8_t learnLookup(uint32_t);
+static void learnWait(uint16_t);
+
+/******************************************************************************
+* LearnRun - Public Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Characterizes an unknown IC. Pin directions are found by
+* 				pull sensing, every input combination is applied and the
+* 				outputs captured into a truth table, and its canonical
+* 				signature is looked up in the library index. With 12 inputs
+* 				4096 combinations take ~25ms.
+*
+* Arguments:    None
+*
+* Return:		Matching IC designator, or LEARN_NO_MATCH
+******************************************************************************/
+uint8_t LearnRun(void)
+{
+	uint32_t start_ms = SysTickGetMS();
+	uint32_t in_masks[LEARN_MAX_PINS];
+	uint32_t out_masks[LEARN_MAX_PINS];
+	uint32_t in_mask = 0U;
+	uint32_t out_mask = 0U;
+	uint32_t drive = 0U;
+	uint32_t outputs;
+	uint16_t combination;
+	uint16_t gray;
+	uint16_t bit_index;
+	uint8_t changed;
+
+	if(learnIndexValid != TRUE) learnBuildIndex();
+
+	learnResult.out_pins = learnFindOutputs();
+	learnResult.in_pins = 0U;
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if((SocketPinMask[ic_pin] != 0U) && ((learnResult.out_pins & (1U << ic_pin)) == 0U)) learnResult.in_pins |= (1U << ic_pin);
+	}
+	learnResult.num_inputs = learnPinMasks(learnResult.in_pins, in_masks);
+	learnResult.num_outputs = learnPinMasks(learnResult.out_pins, out_masks);
+	for(uint8_t index = 0; index < learnResult.num_inputs; index++) in_mask |= in_masks[index];
+	for(uint8_t index = 0; index < learnResult.num_outputs; index++) out_mask |= out_masks[index];
+
+	for(uint8_t index = 0; index < LEARN_TABLE_WORDS; index++) learnTable[index] = 0U;
+
+	SOCKET_WRITE(0U, in_mask);
+	SocketSetOutputs(in_mask);
+	SocketSetInputs(out_mask);
+
+	// Gray code order, combination n differs from n-1 in its lowest set bit
+	for(combination = 0; combination < (1U << learnResult.num_inputs); combination++){
+		if(combination != 0U){
+			for(changed = 0; ((combination >> changed) & 1U) == 0U; changed++);
+			drive ^= in_masks[changed];
+			SOCKET_WRITE(drive, in_mask);
+		}
+		gray = combination ^ (combination >> 1);
+
+		learnWait(CYCLES_DELAY);
+		outputs = SOCKET_READ();
+
+		for(uint8_t index = 0; index < learnResult.num_outputs; index++){
+			if(outputs & out_masks[index]){
+				bit_index = (gray * learnResult.num_outputs) + index;
+				learnTable[bit_index >> 5] |= (1U << (bit_index & 0x1FU));
+			}
+		}
+	}
+	SocketFloat();
+
+	learnResult.signature = learnSignature(learnResult.in_pins, learnResult.out_pins);
+	learnResult.match = learnLookup(learnResult.signature);
+	learnResult.duration_ms = SysTickGetMS() - start_ms;
+
+	return learnResult.match;
+}
+
+/******************************************************************************
+* LearnGetResult - Public Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the result of the last LearnRun.
+*
+* Arguments:    None
+*
+* Return:		Pointer to result
+******************************************************************************/
+const LEARN_RESULT_T *LearnGetResult(void)
+{
+	return &learnResult;
+}
+
+/******************************************************************************
+* LearnGetTable - Public Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the truth table captured by the last LearnRun. Bit
+* 				(combination * num_outputs + output) holds the output level,
+* 				where bit k of the combination drives the kth lowest input
+* 				pin and outputs are in ascending pin order.
+*
+* Arguments:    None
+*
+* Return:		Pointer to LEARN_TABLE_WORDS words
+******************************************************************************/
+const uint32_t *LearnGetTable(void)
+{
+	return learnTable;
+}
+
+/******************************************************************************
+* learnFindOutputs - Private Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds which IC pins are outputs by pull sensing. Every pin
+* 				is read with all pins pulled up and with all pins pulled
+* 				down, then each pin in turn is read pulled against all the
+* 				others in both directions. An input (or unconnected pin)
+* 				always follows its own pull. An output is driven by the IC,
+* 				and each gate type disagrees with its pull in at least one
+* 				of these four cases (e.g. inverting gates with all pins
+* 				pulled alike, AND/OR with the output pulled against its
+* 				inputs).
+*
+* Arguments:    None
+*
+* Return:		Bit field of output IC pins (bit n = IC pin n)
+******************************************************************************/
+static uint16_t learnFindOutputs(void)
+{
+	uint32_t disagree = 0U;
+	uint32_t pin_mask;
+
+	SocketSetInputs(SOCKET_ALL_MASK);
+
+	SocketSetPull(SOCKET_ALL_MASK, SOCKET_PULL_UP);
+	learnWait(CYCLES_DELAY);
+	disagree |= ~SOCKET_READ() & SOCKET_ALL_MASK;
+
+	SocketSetPull(SOCKET_ALL_MASK, SOCKET_PULL_DOWN);
+	learnWait(CYCLES_DELAY);
+	disagree |= SOCKET_READ();
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		pin_mask = SocketPinMask[ic_pin];
+		if(pin_mask == 0U) continue;
+
+		SocketSetPull(SOCKET_ALL_MASK & ~pin_mask, SOCKET_PULL_UP);
+		SocketSetPull(pin_mask, SOCKET_PULL_DOWN);
+		learnWait(CYCLES_DELAY);
+		disagree |= SOCKET_READ() & pin_mask;
+
+		SocketSetPull(SOCKET_ALL_MASK & ~pin_mask, SOCKET_PULL_DOWN);
+		SocketSetPull(pin_mask, SOCKET_PULL_UP);
+		learnWait(CYCLES_DELAY);
+		disagree |= ~SOCKET_READ() & pin_mask;
+	}
+	SocketFloat();
+
+	pin_mask = 0U;
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(disagree & SocketPinMask[ic_pin]) pin_mask |= (1U << ic_pin);
+	}
+	return (uint16_t)pin_mask;
+}
+
+/******************************************************************************
+* learnPinMasks - Private Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Lists the packed socket masks of a set of IC pins in
+* 				ascending pin order.
+*
+* Arguments:    uint16_t pins - Bit field of IC pins (bit n = IC pin n)
+*
+* 				uint32_t *masks - Filled in with one mask per pin
+*
+* Return:		Number of pins
+******************************************************************************/
+static uint8_t learnPinMasks(uint16_t pins, uint32_t *masks)
+{
+	uint8_t num_pins = 0U;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(pins & (1U << ic_pin)) masks[num_pins++] = SocketPinMask[ic_pin];
+	}
+	return num_pins;
+}
+
+/******************************************************************************
+* learnSignature - Private Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Computes the canonical signature of the truth table held in
+* 				learnTable: the CRC of the input pins, the output pins and
+* 				every table word in use.
+*
+* Arguments:    uint16_t in_pins - Input IC pins (bit n = IC pin n)
+*
+* 				uint16_t out_pins - Output IC pins (bit n = IC pin n)
+*
+* Return:		Signature
+******************************************************************************/
+static uint32_t learnSignature(uint16_t in_pins, uint16_t out_pins)
+{
+	uint8_t num_inputs = 0U;
+	uint8_t num_outputs = 0U;
+	uint16_t num_bits;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(in_pins & (1U << ic_pin)) num_inputs++;
+		if(out_pins & (1U << ic_pin)) num_outputs++;
+	}
+	num_bits = (1U << num_inputs) * num_outputs;
+
+	CRC->CR = CRC_CR_RESET;
+	CRC->DR = ((uint32_t)out_pins << 16) | in_pins;
+	for(uint8_t index = 0; index < ((num_bits + 31U) >> 5); index++){
+		CRC->DR = learnTable[index];
+	}
+	return CRC->DR;
+}
+
+/******************************************************************************
+* learnBuildIndex - Private Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Builds the truth table of every library IC from its failure
+* 				function (see CheckerEvaluate), exactly as LearnRun would
+* 				capture it, and adds its signature to the hash index.
+* 				Every socket pin that is not an IC output is an input.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void learnBuildIndex(void)
+{
+	const IC_PARAMETERS_T *IC;
+	uint32_t in_masks[LEARN_MAX_PINS];
+	uint32_t out_masks[LEARN_MAX_PINS];
+	uint16_t in_pins;
+	uint16_t out_pins;
+	uint8_t num_inputs;
+	uint8_t num_outputs;
+	uint32_t drive;
+	uint32_t outputs;
+	uint16_t bit_index;
+	uint32_t signature;
+	uint8_t slot;
+
+	for(slot = 0; slot < LEARN_INDEX_SIZE; slot++) learnIndexDesignator[slot] = LEARN_EMPTY_SLOT;
+
+	for(uint8_t lib = 0; lib < LEARN_LIBRARY_SIZE; lib++){
+		IC = learnLibrary[lib];
+
+		out_pins = 0U;
+		for(uint8_t index = 0; index < IC->num_outputs; index++) out_pins |= (1U << IC->output_pins[index]);
+		in_pins = 0U;
+		for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+			if((SocketPinMask[ic_pin] != 0U) && ((out_pins & (1U << ic_pin)) == 0U)) in_pins |= (1U << ic_pin);
+		}
+		num_inputs = learnPinMasks(in_pins, in_masks);
+		num_outputs = learnPinMasks(out_pins, out_masks);
+
+		for(uint8_t index = 0; index < LEARN_TABLE_WORDS; index++) learnTable[index] = 0U;
+
+		for(uint16_t combination = 0; combination < (1U << num_inputs); combination++){
+			drive = 0U;
+			for(uint8_t index = 0; index < num_inputs; index++){
+				if(combination & (1U << index)) drive |= in_masks[index];
+			}
+			outputs = CheckerEvaluate(IC, drive);
+
+			for(uint8_t index = 0; index < num_outputs; index++){
+				if(outputs & out_masks[index]){
+					bit_index = (combination * num_outputs) + index;
+					learnTable[bit_index >> 5] |= (1U << (bit_index & 0x1FU));
+				}
+			}
+		}
+
+		// Open addressing, linear probe
+		signature = learnSignature(in_pins, out_pins);
+		slot = signature & (LEARN_INDEX_SIZE - 1U);
+		while(learnIndexDesignator[slot] != LEARN_EMPTY_SLOT) slot = (slot + 1U) & (LEARN_INDEX_SIZE - 1U);
+		learnIndexKey[slot] = signature;
+		learnIndexDesignator[slot] = IC->ic_designator;
+	}
+
+	learnIndexValid = TRUE;
+}
+
+/******************************************************************************
+* learnLookup - Private Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Looks a signature up in the library hash index.
+*
+* Arguments:    uint32_t signature - Canonical truth table signature
+*
+* Return:		Matching IC designator, or LEARN_NO_MATCH
+******************************************************************************/
+static uint8_t learnLookup(uint32_t signature)
+{
+	uint8_t slot = signature & (LEARN_INDEX_SIZE - 1U);
+
+	while(learnIndexDesignator[slot] != LEARN_EMPTY_SLOT){
+		if(learnIndexKey[slot] == signature) return learnIndexDesignator[slot];
+		slot = (slot + 1U) & (LEARN_INDEX_SIZE - 1U);
+	}
+	return LEARN_NO_MATCH;
+}
+
+/******************************************************************************
+* learnWait - Private Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits the given number of SYSCLK cycles on the timestamp
+* 				counter.
+*
+* Arguments:    uint16_t cycles - Cycles to wait
+*
+* Return:		None
+******************************************************************************/
+static void learnWait(uint16_t cycles)
+{
+	uint16_t start = TIMESTAMP_NOW();
+
+	while((uint16_t)(TIMESTAMP_NOW() - start) < cycles){}
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+* 	Learn.h
+*
+* 	Header for Learn.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/13/2019:
+* 	Created black-box truth table learning and library matching.
+*
+* 	Created on: 08/13/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef LEARN_H_
+#define LEARN_H_
+
+#include "Checker.h"
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define LEARN_NO_MATCH 0xFFU
+// Learned designator when the function matches no library IC
+
+#define LEARN_TABLE_WORDS 64U
+// Truth table storage in words. With every socket pin either an input or an
+// output, 2^n combinations of m = 12 - n outputs never exceed 2048 bits.
+
+#define LEARN_INDEX_SIZE 16U
+// Slots in the library signature hash index (power of 2, more than twice
+// the number of combinational library ICs)
+
+typedef struct {
+	uint16_t in_pins;
+	uint16_t out_pins;
+	uint8_t num_inputs;
+	uint8_t num_outputs;
+	uint32_t signature;
+	uint8_t match;
+	uint16_t duration_ms;
+} LEARN_RESULT_T;
+// Result of the last LearnRun: discovered input and output IC pins (bit n =
+// IC pin n), canonical truth table signature, matching library designator
+// (LEARN_NO_MATCH for a new function) and time taken
+
+/******************************************************************************
+* LearnRun - Public Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Characterizes an unknown IC. Pin directions are found by
+* 				pull sensing, every input combination is applied and the
+* 				outputs captured into a truth table, and its canonical
+* 				signature is looked up in the library index.
+*
+* Arguments:    None
+*
+* Return:		Matching IC designator, or LEARN_NO_MATCH
+******************************************************************************/
+uint8_t LearnRun(void);
+
+/******************************************************************************
+* LearnGetResult - Public Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the result of the last LearnRun.
+*
+* Arguments:    None
+*
+* Return:		Pointer to result
+******************************************************************************/
+const LEARN_RESULT_T *LearnGetResult(void);
+
+/******************************************************************************
+* LearnGetTable - Public Function
+*
+* 08/13/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the truth table captured by the last LearnRun. Bit
+* 				(combination * num_outputs + output) holds the output level,
+* 				where bit k of the combination drives the kth lowest input
+* 				pin and outputs are in ascending pin order.
+*
+* Arguments:    None
+*
+* Return:		Pointer to LEARN_TABLE_WORDS words
+******************************************************************************/
+const uint32_t *LearnGetTable(void);
+
+#endif /* LEARN_H_ */
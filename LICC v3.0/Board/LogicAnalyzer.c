@@ -0,0 +1,339 @@
+/******************************************************************************
+* 	LogicAnalyzer.c
+*
+* 	This source file turns the socket into a 12 channel logic analyzer. TIM1
+* 	compares 2 and 4 request DMA1 channels 3 and 4 to copy GPIOA and GPIOB
+* 	IDR into a circular raw buffer at the sample rate. The CPU compresses
+* 	each half of the raw buffer into run-length entries while DMA fills the
+* 	other half, so capture depth is set by how often the pins change rather
+* 	than by RAM. Run-length entries are kept in a ring until the trigger,
+* 	giving pre-trigger history. Dependent on 48MHz TIM1 clock.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/14/2019:
+* 	Created 12 channel logic analyzer with run-length compressed capture.
+*
+* 	08/30/2019:
+* 	Overrun found from the flag of the half being filled.
+*
+* 	08/31/2019:
+* 	Receive DMA stopped for capture so a host byte can stop a capture that
+* 	never triggers.
+*
+* 	Created on: 08/14/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "SysTick.h"
+#include "Usart1.h"
+#include "Socket.h"
+#include "Workspace.h"
+#include "LogicAnalyzer.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+
+#define LA_TIM_CLK_HZ 48000000U
+
+#define LA_RAW_SAMPLES 256U
+// Raw circular buffer length per port, compressed half at a time
+
+#define LA_RLE_ENTRIES (WORKSPACE_WORDS - LA_RAW_SAMPLES)
+// Raw buffers take LA_RAW_SAMPLES words (two ports of halfwords), the rest
+// of the workspace holds run-length entries
+
+#define LA_MAX_RUN (1UL << (32U - LA_RUN_SHIFT))
+// Longest run held by a single entry
+
+#define LA_SAMPLE_COMPARE 1U
+// TIM1 count at which both ports are sampled
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static LA_HEADER_T laHeader;
+static uint32_t *laRle;
+static uint16_t laTail;
+static uint16_t laCount;
+static uint32_t laPreSamples;
+static uint8_t laTriggered;
+static uint8_t laStop;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint16_t laPinsToWord(uint16_t);
+static void laEmit(uint16_t, uint32_t);
+static void laTrimPreTrigger(uint32_t);
+
+/******************************************************************************
+* LaCapture - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Overrun tested on the flag of the other half, which
+* 				sets as soon as DMA wraps into the half being read.
+*
+* 08/31/2019:	Anthony Needles
+* 				Host byte stops a capture waiting for its trigger.
+*
+* Description:  Floats every socket pin and samples all 12 at the requested
+* 				rate until the trigger pattern is seen and post_samples
+* 				more have been taken, or the timeout expires. Any host
+* 				byte received before the trigger stops the capture, so a
+* 				trigger that never comes with no timeout cannot hang the
+* 				instrument. USART1 receive DMA is stopped, as it would
+* 				take that byte before it is seen. The command ring must
+* 				be restarted afterwards (CommandInit). Samples are
+* 				run-length compressed into the workspace as they arrive.
+* 				The trigger is only armed once pre_samples have been taken
+* 				(or the entry ring is full). Leading history beyond
+* 				pre_samples is dropped once capture ends.
+*
+* Arguments:    const LA_CONFIG_T *config - Capture settings
+*
+* Return:		Capture header (also kept for LaStream)
+******************************************************************************/
+const LA_HEADER_T *LaCapture(const LA_CONFIG_T *config)
+{
+	uint16_t *raw_a = (uint16_t *)Workspace;
+	uint16_t *raw_b = raw_a + LA_RAW_SAMPLES;
+	uint16_t trig_mask = laPinsToWord(config->trig_pins);
+	uint16_t trig_word = laPinsToWord(config->trig_levels) & trig_mask;
+	uint32_t rate_hz = (config->rate_hz > LA_MAX_RATE_HZ) ? LA_MAX_RATE_HZ : config->rate_hz;
+	uint32_t period = LA_TIM_CLK_HZ / ((rate_hz != 0U) ? rate_hz : 1U);
+	uint32_t prescale = period >> 16;
+	uint32_t start_ms = SysTickGetMS();
+	uint32_t post_count = 0U;
+	uint32_t run = 0U;
+	uint16_t word;
+	uint16_t current = 0U;
+	uint16_t first;
+	uint32_t half_flag;
+
+	laRle = Workspace + LA_RAW_SAMPLES;
+	laTail = 0U;
+	laCount = 0U;
+	laPreSamples = 0U;
+	laTriggered = 0U;
+	laStop = 0U;
+	laHeader.magic = LA_MAGIC;
+	laHeader.flags = 0U;
+	laHeader.trigger_entry = 0U;
+
+	SocketFloat();
+
+	// DMA1 channel 4 is shared with USART1 TX
+	while(Usart1TxDone() == 0U){}
+
+	// A host byte left over from before would stop capture at once
+	Usart1RxStop();
+	while(USART1->ISR & USART_ISR_RXNE) (void)USART1->RDR;
+
+	DMA1_Channel3->CCR = 0U;
+	DMA1_Channel3->CPAR = (uint32_t)&GPIOA->IDR;
+	DMA1_Channel3->CMAR = (uint32_t)raw_a;
+	DMA1_Channel3->CNDTR = LA_RAW_SAMPLES;
+	DMA1_Channel3->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_EN;
+
+	DMA1_Channel4->CCR = 0U;
+	DMA1_Channel4->CPAR = (uint32_t)&GPIOB->IDR;
+	DMA1_Channel4->CMAR = (uint32_t)raw_b;
+	DMA1_Channel4->CNDTR = LA_RAW_SAMPLES;
+	DMA1_Channel4->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_EN;
+
+	DMA1->IFCR = DMA_IFCR_CGIF3 | DMA_IFCR_CGIF4;
+
+	TIM1->CR1 = 0U;
+	TIM1->PSC = prescale;
+	TIM1->ARR = (period / (prescale + 1U)) - 1U;
+	TIM1->CCR2 = LA_SAMPLE_COMPARE;
+	TIM1->CCR4 = LA_SAMPLE_COMPARE;
+	TIM1->EGR = TIM_EGR_UG;
+	TIM1->SR = 0U;
+	TIM1->DIER = TIM_DIER_CC2DE | TIM_DIER_CC4DE;
+	TIM1->CR1 = TIM_CR1_CEN;
+	laHeader.rate_hz = LA_TIM_CLK_HZ / ((prescale + 1U) * (TIM1->ARR + 1U));
+
+	// Channel 4 completes after channel 3 for the same sample, so its flags
+	// mark when both ports of a half are in
+	first = 0U;
+	while(laStop != TRUE){
+		half_flag = (first == 0U) ? DMA_ISR_HTIF4 : DMA_ISR_TCIF4;
+		while((DMA1->ISR & half_flag) == 0U){
+			if((laTriggered != TRUE) && (USART1->ISR & USART_ISR_RXNE)){
+				(void)USART1->RDR;
+				laHeader.flags |= LA_FLAG_STOPPED;
+				laStop = TRUE;
+				break;
+			}
+			if((laTriggered != TRUE) && (config->timeout_ms != 0U) && ((SysTickGetMS() - start_ms) >= config->timeout_ms)){
+				laStop = TRUE;
+				break;
+			}
+		}
+		if(laStop == TRUE) break;
+		DMA1->IFCR = half_flag;
+
+		for(uint16_t index = first; index < (first + (LA_RAW_SAMPLES / 2U)); index++){
+			word = LA_PACK(raw_a[index], raw_b[index]);
+
+			if(laTriggered != TRUE){
+				// Trigger sample always starts a new entry
+				if(((laPreSamples >= config->pre_samples) || (laCount == LA_RLE_ENTRIES))
+				   && ((word & trig_mask) == trig_word)){
+					if(run != 0U) laEmit(current, run);
+					laTriggered = TRUE;
+					laHeader.trigger_entry = laCount;
+					current = word;
+					run = 1U;
+					post_count = 1U;
+					continue;
+				}
+				laPreSamples++;
+			} else if(++post_count > config->post_samples){
+				laStop = TRUE;
+				break;
+			}
+
+			if((word == current) && (run != 0U) && (run < LA_MAX_RUN)){
+				run++;
+			} else {
+				if(run != 0U) laEmit(current, run);
+				current = word;
+				run = 1U;
+			}
+			if(laStop == TRUE) break;
+		}
+
+		// DMA finished the other half and wrapped into this one before we
+		// finished, so part of it was overwritten. The flag of this half
+		// would only set once the whole half had been written again.
+		if(DMA1->ISR & ((first == 0U) ? DMA_ISR_TCIF4 : DMA_ISR_HTIF4)) laHeader.flags |= LA_FLAG_OVERRUN;
+		first ^= (LA_RAW_SAMPLES / 2U);
+	}
+
+	TIM1->CR1 = 0U;
+	TIM1->DIER = 0U;
+	DMA1_Channel3->CCR = 0U;
+	DMA1_Channel4->CCR = 0U;
+
+	if(run != 0U) laEmit(current, run);
+	if(laTriggered == TRUE) laTrimPreTrigger(config->pre_samples);
+
+	laHeader.triggered = laTriggered;
+	laHeader.num_entries = laCount;
+	return &laHeader;
+}
+
+/******************************************************************************
+* LaStream - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sends the last capture over USART1: the header then every
+* 				RLE entry, oldest first. The entry ring is sent as at most
+* 				two DMA transmits.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void LaStream(void)
+{
+	uint16_t first_len = ((laTail + laCount) > LA_RLE_ENTRIES) ? (LA_RLE_ENTRIES - laTail) : laCount;
+
+	Usart1Write(&laHeader, sizeof(laHeader));
+	Usart1Write(&laRle[laTail], first_len * sizeof(uint32_t));
+	Usart1Write(laRle, (laCount - first_len) * sizeof(uint32_t));
+	Usart1Flush();
+}
+
+/******************************************************************************
+* laPinsToWord - Private Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a bit field of IC pins into analyzer word bits.
+*
+* Arguments:    uint16_t ic_pins - Bit field of IC pins (bit n = IC pin n)
+*
+* Return:		Analyzer word
+******************************************************************************/
+static uint16_t laPinsToWord(uint16_t ic_pins)
+{
+	uint16_t word = 0U;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(ic_pins & (1U << ic_pin)) word |= LA_PACK(SocketPinMask[ic_pin] & 0xFFFFU, SocketPinMask[ic_pin] >> 16);
+	}
+	return word;
+}
+
+/******************************************************************************
+* laEmit - Private Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Appends a run-length entry to the ring. Before the trigger
+* 				a full ring drops its oldest entry. After the trigger the
+* 				pre-trigger history is kept and a full ring ends capture.
+*
+* Arguments:    uint16_t word - Analyzer word
+*
+* 				uint32_t run - Number of samples (1 to LA_MAX_RUN)
+*
+* Return:		None
+******************************************************************************/
+static void laEmit(uint16_t word, uint32_t run)
+{
+	if(laCount == LA_RLE_ENTRIES){
+		if(laTriggered == TRUE){
+			laHeader.flags |= LA_FLAG_TRUNCATED;
+			laStop = TRUE;
+			return;
+		}
+		laPreSamples -= (laRle[laTail] >> LA_RUN_SHIFT) + 1U;
+		laTail = (laTail + 1U) % LA_RLE_ENTRIES;
+		laCount--;
+	}
+
+	laRle[(laTail + laCount) % LA_RLE_ENTRIES] = word | ((run - 1U) << LA_RUN_SHIFT);
+	laCount++;
+}
+
+/******************************************************************************
+* laTrimPreTrigger - Private Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Drops the oldest entries that are not needed to give the
+* 				requested pre-trigger history.
+*
+* Arguments:    uint32_t pre_samples - Pre-trigger samples requested
+*
+* Return:		None
+******************************************************************************/
+static void laTrimPreTrigger(uint32_t pre_samples)
+{
+	uint32_t oldest_run;
+
+	while(laHeader.trigger_entry > 0U){
+		oldest_run = (laRle[laTail] >> LA_RUN_SHIFT) + 1U;
+		if((laPreSamples - oldest_run) < pre_samples) break;
+
+		laPreSamples -= oldest_run;
+		laTail = (laTail + 1U) % LA_RLE_ENTRIES;
+		laCount--;
+		laHeader.trigger_entry--;
+	}
+}
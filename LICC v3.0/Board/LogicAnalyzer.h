@@ -0,0 +1,113 @@
+/******************************************************************************
+* 	LogicAnalyzer.h
+*
+* 	Header for LogicAnalyzer.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/14/2019:
+* 	Created 12 channel logic analyzer with run-length compressed capture.
+*
+* 	08/15/2019:
+* 	Added LA_UNPACK for replaying captures with the pattern generator.
+*
+* 	08/31/2019:
+* 	A host byte stops a capture still waiting for its trigger.
+*
+* 	Created on: 08/14/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef LOGICANALYZER_H_
+#define LOGICANALYZER_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define LA_MAX_RATE_HZ 1000000U
+// Highest sample rate. Each sample costs two DMA transfers and ~20 SYSCLK
+// cycles of compression, 48 cycles per sample leaves margin for both.
+
+#define LA_PACK(port_a, port_b) (((port_a) & 0x00FEU) | (((port_b) & 0x0007U) << 8) | (((port_b) & 0x0C00U) << 1))
+// Packs GPIOA and GPIOB IDR into a 13 bit analyzer word: bits [7:1] PA7-PA1
+// (IC pins 6, 13-8), bits [10:8] PB2-PB0 (IC pins 3-5), bits [12:11] PB11,
+// PB10 (IC pins 1, 2)
+
+#define LA_UNPACK(word) (((word) & 0x00FEU) | (((word) & 0x0700U) << 8) | (((word) & 0x1800U) << 15))
+// Converts an analyzer word back into a packed socket word
+
+#define LA_RUN_SHIFT 13U
+// RLE entry: bits [12:0] analyzer word, bits [31:13] run length - 1
+
+#define LA_MAGIC 0x414CU
+// "LA", start of a streamed capture
+
+typedef struct {
+	uint32_t rate_hz;
+	uint16_t trig_pins;
+	uint16_t trig_levels;
+	uint32_t pre_samples;
+	uint32_t post_samples;
+	uint32_t timeout_ms;
+} LA_CONFIG_T;
+// Capture settings: sample rate, IC pins in the trigger pattern and their
+// levels (bit n = IC pin n, no pins triggers at once), samples to keep before
+// and after the trigger, and ms to wait for the trigger (0 waits until a
+// host byte stops the capture)
+
+typedef struct {
+	uint16_t magic;
+	uint8_t triggered;
+	uint8_t flags;
+	uint32_t rate_hz;
+	uint16_t num_entries;
+	uint16_t trigger_entry;
+} LA_HEADER_T;
+// Streamed ahead of the RLE entries of a capture. The trigger sample starts
+// entry trigger_entry.
+
+#define LA_FLAG_OVERRUN 0x01U
+#define LA_FLAG_TRUNCATED 0x02U
+#define LA_FLAG_STOPPED 0x04U
+// Capture flags: compression fell behind DMA (samples lost), the buffer
+// filled before post_samples were captured, or a host byte stopped the
+// capture before the trigger
+
+/******************************************************************************
+* LaCapture - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Host byte stops a capture waiting for its trigger.
+*
+* Description:  Floats every socket pin and samples all 12 at the requested
+* 				rate until the trigger pattern is seen and post_samples
+* 				more have been taken, or the timeout expires, or a host
+* 				byte arrives before the trigger. Samples are run-length
+* 				compressed into the workspace as they arrive. USART1
+* 				receive DMA is stopped, the command ring must be
+* 				restarted afterwards (CommandInit).
+*
+* Arguments:    const LA_CONFIG_T *config - Capture settings
+*
+* Return:		Capture header (also kept for LaStream)
+******************************************************************************/
+const LA_HEADER_T *LaCapture(const LA_CONFIG_T*);
+
+/******************************************************************************
+* LaStream - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sends the last capture over USART1: the header then every
+* 				RLE entry, oldest first.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void LaStream(void);
+
+#endif /* LOGICANALYZER_H_ */
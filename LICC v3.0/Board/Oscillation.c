@@ -0,0 +1,288 @@
+/******************************************************************************
+* 	Oscillation.c
+*
+* 	This source file detects IC outputs that oscillate instead of settling,
+* 	which is typical of damaged inverters and buffers. Outputs are sampled
+* 	many times during the settle window and transitions are counted per pin.
+* 	Oscillating pins that are routed to a timer channel have their frequency
+* 	measured by input capture. Dependent on 48MHz timer clocks and the TIM6
+* 	timestamp counter.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/05/2019:
+* 	Created output oscillation detector with input capture frequency estimate.
+*
+* 	08/31/2019:
+* 	Capture pin mode changes made atomic against the over-current interrupt.
+*
+* 	Created on: 08/05/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Oscillation.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define OSC_CAPTURE_TIMEOUT 2U
+// Number of timer overflows (~1.37ms each) without an edge before a capture
+// is abandoned
+
+typedef struct {
+	TIM_TypeDef *timer;
+	uint8_t channel;
+	uint8_t alt_func;
+} OSC_CAPTURE_T;
+// Timer input capture channel and alternate function routed to an IC pin
+
+/******************************************************************************
+* Private Constants
+******************************************************************************/
+static const OSC_CAPTURE_T oscCaptureMap[SOCKET_NUM_PINS + 1] = {
+	{0, 0, 0},			// (unused)
+	{0, 0, 0},			// Pin 1  - PB11, no timer channel
+	{0, 0, 0},			// Pin 2  - PB10, no timer channel
+	{0, 0, 0},			// Pin 3  - PB2, no timer channel
+	{TIM3, 4, 1},		// Pin 4  - PB1, TIM3_CH4 AF1
+	{TIM3, 3, 1},		// Pin 5  - PB0, TIM3_CH3 AF1
+	{TIM3, 2, 1},		// Pin 6  - PA7, TIM3_CH2 AF1
+	{0, 0, 0},			// Pin 7  - GND
+	{TIM3, 1, 1},		// Pin 8  - PA6, TIM3_CH1 AF1
+	{0, 0, 0},			// Pin 9  - PA5, no timer channel
+	{TIM14, 1, 4},		// Pin 10 - PA4, TIM14_CH1 AF4
+	{TIM15, 2, 0},		// Pin 11 - PA3, TIM15_CH2 AF0
+	{TIM15, 1, 0},		// Pin 12 - PA2, TIM15_CH1 AF0
+	{0, 0, 0},			// Pin 13 - PA1, no timer channel
+	{0, 0, 0}			// Pin 14 - VCC
+};
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint32_t oscSamples[OSC_MAX_SAMPLES];
+static uint32_t oscFrequency[SOCKET_NUM_PINS + 1];
+static uint16_t oscFlaggedPins = 0U;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint32_t oscCaptureFrequency(uint8_t);
+
+/******************************************************************************
+* OscInit - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables clocks for the timers used for input capture
+* 				(TIM3, TIM14, TIM15) and clears all detector results.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OscInit(void)
+{
+	RCC->APB1ENR |= (RCC_APB1ENR_TIM3EN | RCC_APB1ENR_TIM14EN);
+	RCC->APB2ENR |= RCC_APB2ENR_TIM15EN;
+
+	OscReset();
+}
+
+/******************************************************************************
+* OscReset - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears per-pin transition counts, frequency estimates and
+* 				flagged pins before a new post-pass.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OscReset(void)
+{
+	for(uint8_t ic_pin = 0; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		oscFrequency[ic_pin] = 0U;
+	}
+	oscFlaggedPins = 0U;
+}
+
+/******************************************************************************
+* OscSampleOutputs - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Samples all socket pins as fast as possible for the given
+* 				window and counts transitions on the requested outputs. Any
+* 				output exceeding OSC_TRANSITION_LIMIT is flagged and has its
+* 				oscillation frequency estimated while the inputs that caused
+* 				it are still applied.
+*
+* Arguments:    uint32_t out_mask - Packed socket mask of outputs to check
+*
+* 				uint16_t window - Sample window length in SYSCLK cycles
+*
+* Return:		None
+******************************************************************************/
+void OscSampleOutputs(uint32_t out_mask, uint16_t window)
+{
+	uint16_t start_time = TIMESTAMP_NOW();
+	uint16_t elapsed;
+	uint8_t num_samples = 0;
+	uint8_t transitions;
+
+	// Tight sample loop, processing is deferred until the window is over
+	do{
+		oscSamples[num_samples++] = SOCKET_READ();
+		elapsed = (uint16_t)(TIMESTAMP_NOW() - start_time);
+	} while((num_samples < OSC_MAX_SAMPLES) && (elapsed < window));
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		uint32_t pin_mask = SocketPinMask[ic_pin] & out_mask;
+
+		if((pin_mask == 0U) || (oscFlaggedPins & (1U << ic_pin))) continue;
+
+		transitions = 0;
+		for(uint8_t sample = 1; sample < num_samples; sample++){
+			if((oscSamples[sample] ^ oscSamples[sample - 1]) & pin_mask) transitions++;
+		}
+
+		if(transitions > OSC_TRANSITION_LIMIT){
+			oscFlaggedPins |= (1U << ic_pin);
+
+			if(oscCaptureMap[ic_pin].timer != 0){
+				oscFrequency[ic_pin] = oscCaptureFrequency(ic_pin);
+			} else if(elapsed != 0U){
+				// Two transitions per period over the measured window
+				oscFrequency[ic_pin] = ((TIMESTAMP_CLK_HZ / 2U) / elapsed) * transitions;
+			}
+		}
+	}
+}
+
+/******************************************************************************
+* OscGetFlaggedPins - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns which IC pins have been flagged as oscillating since
+* 				the last OscReset.
+*
+* Arguments:    None
+*
+* Return:		Bit field of flagged IC pins (bit n = IC pin n)
+******************************************************************************/
+uint16_t OscGetFlaggedPins(void)
+{
+	return oscFlaggedPins;
+}
+
+/******************************************************************************
+* OscGetFrequency - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the oscillation frequency estimate of a flagged pin.
+* 				Pins routed to a timer channel are measured by input capture,
+* 				others are estimated from the transition count and the length
+* 				of the sample window.
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* Return:		Frequency estimate in Hz (0 if not flagged)
+******************************************************************************/
+uint32_t OscGetFrequency(uint8_t ic_pin)
+{
+	return (ic_pin <= SOCKET_NUM_PINS) ? oscFrequency[ic_pin] : 0U;
+}
+
+/******************************************************************************
+* oscCaptureFrequency - Private Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Mode register updates guarded by SOCKET_MODE_LOCK.
+*
+* Description:  Temporarily routes the IC pin to its timer channel in input
+* 				capture mode (rising edge, no filter) and averages the period
+* 				over OSC_CAPTURE_PERIODS edges. The pin is returned to input
+* 				mode afterwards. Both mode changes are guarded against an
+* 				over-current shutdown (see SOCKET_MODE_LOCK). Gives up if
+* 				no edge arrives within OSC_CAPTURE_TIMEOUT counter
+* 				overflows.
+*
+* Arguments:    uint8_t ic_pin - IC pin number (must have a capture channel)
+*
+* Return:		Measured frequency in Hz (0 if capture timed out)
+******************************************************************************/
+static uint32_t oscCaptureFrequency(uint8_t ic_pin)
+{
+	const OSC_CAPTURE_T *capture = &oscCaptureMap[ic_pin];
+	TIM_TypeDef *timer = capture->timer;
+	uint8_t bit;
+	GPIO_TypeDef *port = SocketPinPort(ic_pin, &bit);
+	uint8_t ch_index = capture->channel - 1;
+	volatile uint32_t *ccmr = (ch_index < 2) ? &timer->CCMR1 : &timer->CCMR2;
+	volatile uint32_t *ccr = &timer->CCR1 + ch_index;
+	uint8_t ccmr_shift = (ch_index & 0x1) * 8;
+	uint32_t cc_flag = (TIM_SR_CC1IF << ch_index);
+	uint16_t last_edge = 0;
+	uint32_t total_cycles = 0;
+	uint8_t edges = 0;
+	uint8_t overflows = 0;
+	uint32_t oc_enable;
+
+	// Route pin to timer channel alternate function
+	port->AFR[bit >> 3] = ((port->AFR[bit >> 3] & ~(0xFU << ((bit & 0x7) * 4)))
+						  | ((uint32_t)capture->alt_func << ((bit & 0x7) * 4)));
+	SOCKET_MODE_LOCK(oc_enable);
+	port->MODER = ((port->MODER & ~(0x3U << (bit * 2))) | (0x2U << (bit * 2)));
+	SOCKET_MODE_UNLOCK(oc_enable);
+
+	// Channel mapped on TIx as input capture, rising edge, free-running counter
+	timer->CR1 = 0U;
+	timer->PSC = 0U;
+	timer->ARR = 0xFFFFU;
+	*ccmr = ((*ccmr & ~(0xFFU << ccmr_shift)) | (TIM_CCMR1_CC1S_0 << ccmr_shift));
+	timer->CCER = ((timer->CCER & ~(0xFU << (ch_index * 4))) | (TIM_CCER_CC1E << (ch_index * 4)));
+	timer->EGR = TIM_EGR_UG;
+	timer->SR = 0U;
+	timer->CR1 |= TIM_CR1_CEN;
+
+	while((edges <= OSC_CAPTURE_PERIODS) && (overflows < OSC_CAPTURE_TIMEOUT)){
+		if(timer->SR & cc_flag){
+			// Reading CCR clears the capture flag
+			uint16_t edge = (uint16_t)*ccr;
+
+			if(edges != 0) total_cycles += (uint16_t)(edge - last_edge);
+			last_edge = edge;
+			edges++;
+			overflows = 0;
+		} else if(timer->SR & TIM_SR_UIF){
+			timer->SR = ~TIM_SR_UIF;
+			overflows++;
+		}
+	}
+
+	timer->CR1 &= ~TIM_CR1_CEN;
+	timer->CCER &= ~(TIM_CCER_CC1E << (ch_index * 4));
+	SOCKET_MODE_LOCK(oc_enable);
+	port->MODER &= ~(0x3U << (bit * 2));
+	SOCKET_MODE_UNLOCK(oc_enable);
+
+	if((edges <= OSC_CAPTURE_PERIODS) || (total_cycles == 0U)) return 0U;
+
+	return ((TIMESTAMP_CLK_HZ / total_cycles) * OSC_CAPTURE_PERIODS)
+		   + (((TIMESTAMP_CLK_HZ % total_cycles) * OSC_CAPTURE_PERIODS) / total_cycles);
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+* 	Oscillation.h
+*
+* 	Header for Oscillation.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/05/2019:
+* 	Created output oscillation detector with input capture frequency estimate.
+*
+* 	Created on: 08/05/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef OSCILLATION_H_
+#define OSCILLATION_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define OSC_MAX_SAMPLES 64U
+// Most output samples taken during a single settle window
+
+#define OSC_TRANSITION_LIMIT 2U
+// Outputs with more than this many transitions within one settle window are
+// flagged as oscillating. One transition is expected when the output is still
+// completing its edge, a second allows for a single glitch.
+
+#define OSC_CAPTURE_PERIODS 8U
+// Number of periods averaged when measuring frequency by input capture
+
+/******************************************************************************
+* OscInit - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables clocks for the timers used for input capture
+* 				(TIM3, TIM14, TIM15) and clears all detector results.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OscInit(void);
+
+/******************************************************************************
+* OscReset - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears per-pin transition counts, frequency estimates and
+* 				flagged pins before a new post-pass.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OscReset(void);
+
+/******************************************************************************
+* OscSampleOutputs - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Samples all socket pins as fast as possible for the given
+* 				window and counts transitions on the requested outputs. Any
+* 				output exceeding OSC_TRANSITION_LIMIT is flagged and has its
+* 				oscillation frequency estimated while the inputs that caused
+* 				it are still applied.
+*
+* Arguments:    uint32_t out_mask - Packed socket mask of outputs to check
+*
+* 				uint16_t window - Sample window length in SYSCLK cycles
+*
+* Return:		None
+******************************************************************************/
+void OscSampleOutputs(uint32_t, uint16_t);
+
+/******************************************************************************
+* OscGetFlaggedPins - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns which IC pins have been flagged as oscillating since
+* 				the last OscReset.
+*
+* Arguments:    None
+*
+* Return:		Bit field of flagged IC pins (bit n = IC pin n)
+******************************************************************************/
+uint16_t OscGetFlaggedPins(void);
+
+/******************************************************************************
+* OscGetFrequency - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the oscillation frequency estimate of a flagged pin.
+* 				Pins routed to a timer channel are measured by input capture,
+* 				others are estimated from the transition count and the length
+* 				of the sample window.
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* Return:		Frequency estimate in Hz (0 if not flagged)
+******************************************************************************/
+uint32_t OscGetFrequency(uint8_t);
+
+#endif /* OSCILLATION_H_ */
@@ -0,0 +1,258 @@
+/******************************************************************************
+* 	OverCurrent.c
+*
+* 	This source file protects the fixture from reversed or shorted ICs. The
+* 	ADC converts the socket supply current sense input continuously while a
+* 	test runs and its analog watchdog raises the highest priority interrupt
+* 	on any reading over the limit. The interrupt floats every socket pin
+* 	with one mode register write per port, and the checker abandons the
+* 	test. Response time is measured at start up against a conversion
+* 	started at a known time.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/24/2019:
+* 	Created over-current shutdown through the ADC analog watchdog.
+*
+* 	Created on: 08/24/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Adc.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "Iddq.h"
+#include "OverCurrent.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+
+#define OC_MAX_READING (ADC_FULL_SCALE - 1U)
+// Highest threshold, the watchdog fires on readings above it
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static volatile uint8_t ocTripped;
+static volatile uint16_t ocTripTime;
+static uint32_t ocKeepModerA;
+static uint32_t ocKeepModerB;
+static uint16_t ocLimitReading;
+static OC_STATUS_T ocStatus;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static void ocMeasureResponse(void);
+
+/******************************************************************************
+* OcInit - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables the ADC interrupt at the highest priority, measures
+* 				the shutdown response time and sets the default limit.
+* 				AdcInit must have been called.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcInit(void)
+{
+	ocKeepModerA = 0xFFFFFFFFU;
+	ocKeepModerB = 0xFFFFFFFFU;
+	for(uint8_t bit = 0; bit < 16U; bit++){
+		if(SOCKET_ALL_MASK & (1UL << bit)) ocKeepModerA &= ~(3UL << (2U * bit));
+		if(SOCKET_ALL_MASK & (1UL << (bit + 16U))) ocKeepModerB &= ~(3UL << (2U * bit));
+	}
+
+	NVIC_SetPriority(ADC1_IRQn, 0U);
+	NVIC_EnableIRQ(ADC1_IRQn);
+
+	ocMeasureResponse();
+	OcSetLimit(OC_DEFAULT_LIMIT_UA);
+}
+
+/******************************************************************************
+* OcSetLimit - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the socket supply current that floats the socket,
+* 				converted to a reading at nominal VDDA.
+*
+* Arguments:    uint16_t limit_ua - Limit in uA
+*
+* Return:		None
+******************************************************************************/
+void OcSetLimit(uint16_t limit_ua)
+{
+	uint32_t reading = ((uint32_t)limit_ua * IDDQ_SENSE_UV_PER_UA / 1000U) * ADC_FULL_SCALE / ADC_CAL_MV;
+
+	ocStatus.limit_ua = limit_ua;
+	ocLimitReading = (reading > OC_MAX_READING) ? OC_MAX_READING : reading;
+	AdcWatchdogSet(IDDQ_CHANNEL, ocLimitReading);
+}
+
+/******************************************************************************
+* OcArm - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears any trip and starts monitoring the supply current.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcArm(void)
+{
+	ocTripped = 0U;
+	ADC1->ISR = ADC_ISR_AWD;
+	ADC1->IER |= ADC_IER_AWDIE;
+	AdcMonitorStart(IDDQ_CHANNEL);
+}
+
+/******************************************************************************
+* OcResume - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Restarts continuous monitoring after the ADC was used for
+* 				something else, keeping any trip. Conversions of the sense
+* 				input made meanwhile (IDDQ samples) were still guarded.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcResume(void)
+{
+	AdcMonitorStart(IDDQ_CHANNEL);
+}
+
+/******************************************************************************
+* OcDisarm - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Stops monitoring the supply current.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcDisarm(void)
+{
+	ADC1->IER &= ~ADC_IER_AWDIE;
+	AdcMonitorStop();
+}
+
+/******************************************************************************
+* OcTripped - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Tells whether the socket was floated by an over-current
+* 				since OcArm.
+*
+* Arguments:    None
+*
+* Return:		1 if tripped, 0 otherwise
+******************************************************************************/
+uint8_t OcTripped(void)
+{
+	return ocTripped;
+}
+
+/******************************************************************************
+* OcGetStatus - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the trip count, limit and response
+* 				times.
+*
+* Arguments:    None
+*
+* Return:		Pointer to status
+******************************************************************************/
+const OC_STATUS_T *OcGetStatus(void)
+{
+	return &ocStatus;
+}
+
+/******************************************************************************
+* ocMeasureResponse - Private Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Guards VREFINT with a threshold of 0 so its next conversion
+* 				trips, starts that conversion at a known time, and takes
+* 				the time the socket was floated. Less the conversion time
+* 				this is the response from the watchdog flag to the socket
+* 				floated. The socket is already floated at start up.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void ocMeasureResponse(void)
+{
+	uint16_t reading;
+	uint16_t start;
+
+	AdcWatchdogSet(ADC_CHANNEL_VREFINT, 0U);
+	AdcStreamStart(ADC_CHANNEL_VREFINT, &reading, 1U);
+	ocTripped = 0U;
+	ADC1->IER |= ADC_IER_AWDIE;
+
+	start = TIMESTAMP_NOW();
+	ADC_START();
+	while(ocTripped == 0U){}
+	AdcStreamStop();
+
+	ocStatus.response_cycles = (uint16_t)(ocTripTime - start) - ADC_MONITOR_PERIOD_CYCLES;
+	ocStatus.worst_cycles = ocStatus.response_cycles + ADC_MONITOR_PERIOD_CYCLES;
+	ocStatus.trips = 0U;
+	ocTripped = 0U;
+}
+
+/******************************************************************************
+* ADC1_IRQHandler - Interrupt Handler
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Analog watchdog fired, a supply current reading was over the
+* 				limit. Floats every socket pin first, then records the trip.
+* 				The watchdog interrupt is left disabled until the next
+* 				OcArm so the continuing conversions do not fire it again.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void ADC1_IRQHandler(void)
+{
+	GPIOA->MODER &= ocKeepModerA;
+	GPIOB->MODER &= ocKeepModerB;
+	ocTripTime = TIMESTAMP_NOW();
+
+	ADC1->IER &= ~ADC_IER_AWDIE;
+	ADC1->ISR = ADC_ISR_AWD;
+	ocTripped = TRUE;
+	ocStatus.trips++;
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+* 	OverCurrent.h
+*
+* 	Header for OverCurrent.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/24/2019:
+* 	Created over-current shutdown through the ADC analog watchdog.
+*
+* 	Created on: 08/24/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef OVERCURRENT_H_
+#define OVERCURRENT_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define OC_DEFAULT_LIMIT_UA 3000U
+// Socket supply current that floats the socket, near full scale of the
+// current sense (see Iddq.h). A reversed or shorted IC reaches it at once.
+
+typedef struct {
+	uint16_t trips;
+	uint16_t limit_ua;
+	uint16_t response_cycles;
+	uint16_t worst_cycles;
+} OC_STATUS_T;
+// Trips since start up, current limit, and SYSCLK cycles from the watchdog
+// flagging a conversion to the socket being floated (measured at start up),
+// and from the current first exceeding the limit to the socket being
+// floated in the worst case (one monitor conversion period longer)
+
+/******************************************************************************
+* OcInit - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables the ADC interrupt at the highest priority, measures
+* 				the shutdown response time and sets the default limit.
+* 				AdcInit must have been called.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcInit(void);
+
+/******************************************************************************
+* OcSetLimit - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets the socket supply current that floats the socket.
+*
+* Arguments:    uint16_t limit_ua - Limit in uA
+*
+* Return:		None
+******************************************************************************/
+void OcSetLimit(uint16_t);
+
+/******************************************************************************
+* OcArm - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears any trip and starts monitoring the supply current.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcArm(void);
+
+/******************************************************************************
+* OcResume - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Restarts continuous monitoring after the ADC was used for
+* 				something else, keeping any trip.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcResume(void);
+
+/******************************************************************************
+* OcDisarm - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Stops monitoring the supply current.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void OcDisarm(void);
+
+/******************************************************************************
+* OcTripped - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Tells whether the socket was floated by an over-current
+* 				since OcArm.
+*
+* Arguments:    None
+*
+* Return:		1 if tripped, 0 otherwise
+******************************************************************************/
+uint8_t OcTripped(void);
+
+/******************************************************************************
+* OcGetStatus - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the trip count, limit and response
+* 				times.
+*
+* Arguments:    None
+*
+* Return:		Pointer to status
+******************************************************************************/
+const OC_STATUS_T *OcGetStatus(void);
+
+#endif /* OVERCURRENT_H_ */
@@ -0,0 +1,203 @@
+/******************************************************************************
+* 	Parametric.c
+*
+* 	This source file measures the output voltages of a gate IC against its
+* 	family limits, catching parts with degraded output drive that still
+* 	pass the logic test. Every output checked by a vector is converted in
+* 	a single ADC scan together with VREFINT, so each reading is scaled by
+* 	the supply it was taken at. Socket pins 1-3 (PB11, PB10, PB2) have no
+* 	ADC channel, outputs on them are reported as unmeasured.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/21/2019:
+* 	Created parametric VOH/VOL measurement.
+*
+* 	08/26/2019:
+* 	Open-drain outputs have VOL measured only.
+*
+* 	Created on: 08/21/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Adc.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "Parametric.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define FAILED 0U
+
+#define PARAM_NO_CHANNEL 0xFFU
+
+/******************************************************************************
+* Private Constants
+******************************************************************************/
+static const uint8_t paramChannelMap[SOCKET_NUM_PINS + 1] = {
+	PARAM_NO_CHANNEL,	// (unused)
+	PARAM_NO_CHANNEL,	// Pin 1  - PB11, no ADC channel
+	PARAM_NO_CHANNEL,	// Pin 2  - PB10, no ADC channel
+	PARAM_NO_CHANNEL,	// Pin 3  - PB2, no ADC channel
+	9U,					// Pin 4  - PB1, ADC_IN9
+	8U,					// Pin 5  - PB0, ADC_IN8
+	7U,					// Pin 6  - PA7, ADC_IN7
+	PARAM_NO_CHANNEL,	// Pin 7  - GND
+	6U,					// Pin 8  - PA6, ADC_IN6
+	5U,					// Pin 9  - PA5, ADC_IN5
+	4U,					// Pin 10 - PA4, ADC_IN4
+	3U,					// Pin 11 - PA3, ADC_IN3
+	2U,					// Pin 12 - PA2, ADC_IN2
+	1U,					// Pin 13 - PA1, ADC_IN1
+	PARAM_NO_CHANNEL	// Pin 14 - VCC
+};
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint8_t paramSampleIndex(uint32_t, uint8_t);
+
+/******************************************************************************
+* ParamMeasure - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/26/2019:	Anthony Needles
+* 				Open-drain outputs kept on their pull-ups, VOH skipped.
+*
+* Description:  Runs the compiled test program of a gate IC, measuring the
+* 				voltage of every checked output of every vector with one
+* 				ADC scan, and compares the worst levels of each output
+* 				against the family limits. While measured, outputs
+* 				expected high are pulled down and outputs expected low are
+* 				pulled up, loading them by the ~40k pull resistor. Released
+* 				open-drain outputs are only the pull-up, so they stay
+* 				pulled up and have no VOH measured. Pins
+* 				stay in input mode so the pulls remain connected. The high
+* 				limit is taken from VDD measured in the same scan, so the
+* 				comparison is ratiometric and independent of VREFINT
+* 				accuracy.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				PARAM_RESULT_T *result - Filled in with the measurement
+*
+* Return:		PASSED if every measured output is within limits
+******************************************************************************/
+uint8_t ParamMeasure(IC_PARAMETERS_T *IC, PARAM_RESULT_T *result)
+{
+	const CHECKER_PROGRAM_T *program;
+	const CHECKER_VECTOR_T *vector;
+	uint16_t samples[ADC_MAX_CHANNELS];
+	uint32_t channels;
+	uint16_t level_mv;
+	uint16_t start;
+	uint8_t num_samples;
+	uint8_t channel;
+	uint8_t ic_pin;
+	uint8_t index;
+
+	result->passed = PASSED;
+	result->vdd_mv = 0U;
+	result->fail_pins = 0U;
+	result->unmeasured_pins = 0U;
+	for(ic_pin = 0; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		result->voh_mv[ic_pin] = PARAM_NOT_MEASURED;
+		result->vol_mv[ic_pin] = PARAM_NOT_MEASURED;
+	}
+
+	if(IC->ic_class != IC_CLASS_GATE){
+		result->passed = FAILED;
+		return FAILED;
+	}
+
+	for(index = 0; index < IC->num_outputs; index++){
+		ic_pin = IC->output_pins[index];
+		if(paramChannelMap[ic_pin] == PARAM_NO_CHANNEL) result->unmeasured_pins |= (1U << ic_pin);
+	}
+
+	program = CheckerGetProgram(IC);
+
+	SOCKET_WRITE(0U, program->in_mask);
+	SocketSetOutputs(program->in_mask);
+	SocketSetInputs(program->out_mask);
+
+	for(uint8_t vector_num = 0; vector_num < program->num_vectors; vector_num++){
+		vector = &program->vectors[vector_num];
+
+		SOCKET_WRITE(vector->drive, vector->drive_mask);
+		SocketSetPull(vector->care & vector->expect & ~program->od_mask, SOCKET_PULL_DOWN);
+		SocketSetPull(vector->care & (~vector->expect | program->od_mask), SOCKET_PULL_UP);
+
+		channels = (1UL << ADC_CHANNEL_VREFINT);
+		for(index = 0; index < IC->num_outputs; index++){
+			ic_pin = IC->output_pins[index];
+			channel = paramChannelMap[ic_pin];
+			if((channel != PARAM_NO_CHANNEL) && (vector->care & SocketPinMask[ic_pin])) channels |= (1UL << channel);
+		}
+
+		start = TIMESTAMP_NOW();
+		while((uint16_t)(TIMESTAMP_NOW() - start) < program->settle_cycles){}
+
+		// VREFINT is the highest channel converted, so always the last sample
+		num_samples = AdcScan(channels, samples);
+		result->vdd_mv = AdcVddaMv(samples[num_samples - 1U]);
+
+		for(index = 0; index < IC->num_outputs; index++){
+			ic_pin = IC->output_pins[index];
+			channel = paramChannelMap[ic_pin];
+			if((channel == PARAM_NO_CHANNEL) || ((vector->care & SocketPinMask[ic_pin]) == 0U)) continue;
+
+			level_mv = ADC_TO_MV(samples[paramSampleIndex(channels, channel)], result->vdd_mv);
+			if(vector->expect & SocketPinMask[ic_pin]){
+				if(program->od_mask & SocketPinMask[ic_pin]) continue;
+				if(level_mv < result->voh_mv[ic_pin]) result->voh_mv[ic_pin] = level_mv;
+			}
+			else if((result->vol_mv[ic_pin] == PARAM_NOT_MEASURED) || (level_mv > result->vol_mv[ic_pin])){
+				result->vol_mv[ic_pin] = level_mv;
+			}
+		}
+	}
+
+	SocketFloat();
+
+	for(index = 0; index < IC->num_outputs; index++){
+		ic_pin = IC->output_pins[index];
+		if(((result->voh_mv[ic_pin] != PARAM_NOT_MEASURED)
+			&& (((uint32_t)result->voh_mv[ic_pin] + PARAM_VOH_DROP_MV) < result->vdd_mv))
+		   || ((result->vol_mv[ic_pin] != PARAM_NOT_MEASURED) && (result->vol_mv[ic_pin] > PARAM_VOL_MAX_MV))){
+			result->fail_pins |= (1U << ic_pin);
+			result->passed = FAILED;
+		}
+	}
+
+	return result->passed;
+}
+
+/******************************************************************************
+* paramSampleIndex - Private Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds where a channel's result is in the results of a scan,
+* 				channels being converted lowest first.
+*
+* Arguments:    uint32_t channels - Channels converted (bit n = channel n)
+*
+* 				uint8_t channel - Channel to find
+*
+* Return:		Index of the channel's result
+******************************************************************************/
+static uint8_t paramSampleIndex(uint32_t channels, uint8_t channel)
+{
+	uint8_t index = 0U;
+
+	for(uint8_t lower = 0; lower < channel; lower++){
+		if(channels & (1UL << lower)) index++;
+	}
+	return index;
+}
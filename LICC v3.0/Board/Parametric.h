@@ -0,0 +1,61 @@
+/******************************************************************************
+* 	Parametric.h
+*
+* 	Header for Parametric.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/21/2019:
+* 	Created parametric VOH/VOL measurement.
+*
+* 	Created on: 08/21/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef PARAMETRIC_H_
+#define PARAMETRIC_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define PARAM_VOH_DROP_MV 100U
+#define PARAM_VOL_MAX_MV 100U
+// 74HC family limits at light load (20uA, a little under the pull resistor
+// load applied): VOH no lower than VCC - 0.1V, VOL no higher than 0.1V
+
+#define PARAM_NOT_MEASURED 0xFFFFU
+// Voltage of an output not on an ADC pin, or never driven to that level
+
+typedef struct {
+	uint8_t passed;
+	uint16_t vdd_mv;
+	uint16_t fail_pins;
+	uint16_t unmeasured_pins;
+	uint16_t voh_mv[SOCKET_NUM_PINS + 1];
+	uint16_t vol_mv[SOCKET_NUM_PINS + 1];
+} PARAM_RESULT_T;
+// Result of a parametric measurement: pass/fail, supply voltage measured
+// through VREFINT, outputs outside the family limits and outputs on pins
+// with no ADC channel (bit n = IC pin n), and the worst (lowest) high level
+// and worst (highest) low level of each output, indexed by IC pin
+
+/******************************************************************************
+* ParamMeasure - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Runs the compiled test program of a gate IC, measuring the
+* 				voltage of every checked output of every vector with one
+* 				ADC scan, and compares the worst levels of each output
+* 				against the family limits. Outputs are loaded by the pull
+* 				resistor towards the opposite level while measured.
+*
+* Arguments:    IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				PARAM_RESULT_T *result - Filled in with the measurement
+*
+* Return:		PASSED if every measured output is within limits
+******************************************************************************/
+uint8_t ParamMeasure(IC_PARAMETERS_T*, PARAM_RESULT_T*);
+
+#endif /* PARAMETRIC_H_ */
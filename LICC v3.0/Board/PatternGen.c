@@ -0,0 +1,392 @@
+/******************************************************************************
+* 	PatternGen.c
+*
+* 	This source file turns the socket into a pattern generator. TIM1
+* 	compares 1 and 2 request DMA1 channels 2 and 3 to copy BSRR words from
+* 	a circular output buffer into GPIOA and GPIOB BSRR at the step rate, so
+* 	output timing is set by the timer and DMA arbitration alone. The CPU
+* 	expands run-length pattern entries into each half of the output buffer
+* 	while DMA plays the other half. Entries come either from RAM (looped)
+* 	or from the host over USART1 into a double buffered ring on DMA1
+* 	channel 5. Dependent on 48MHz TIM1 clock.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/15/2019:
+* 	Created pattern generator with looped and host streamed playback.
+*
+* 	08/30/2019:
+* 	Underrun found from the flag of the half being played. Receive DMA
+* 	stopped for looped playback so a host byte is seen.
+*
+* 	Created on: 08/15/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "SysTick.h"
+#include "Usart1.h"
+#include "Socket.h"
+#include "Workspace.h"
+#include "LogicAnalyzer.h"
+#include "PatternGen.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+
+#define PG_TIM_CLK_HZ 48000000U
+
+#define PG_PLAY_SAMPLES 128U
+// Output buffer length per port, refilled half at a time
+
+#define PG_HALF (PG_PLAY_SAMPLES / 2U)
+
+#define PG_STREAM_ENTRIES (2U * PG_STREAM_CHUNK)
+// Host stream ring, one chunk played while the other is received
+
+#define PG_OUTPUT_COMPARE 1U
+// TIM1 count at which both ports are written
+
+#define PG_LOAD_TIMEOUT_MS 1000U
+#define PG_STREAM_TIMEOUT_MS 100U
+// Longest wait for a loaded pattern, and for the first streamed chunk
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint32_t *pgPlayA;
+static uint32_t *pgPlayB;
+static uint32_t pgDriveMask;
+static uint32_t pgBsrrA;
+static uint32_t pgBsrrB;
+static uint32_t pgRemain;
+static uint8_t pgEnded;
+static PG_STATUS_T pgStatus;
+
+static const uint32_t *pgSteps;
+static uint16_t pgNumSteps;
+static uint16_t pgIndex;
+static uint16_t pgLoops;
+
+static uint8_t pgStreaming;
+static uint32_t *pgRing;
+static uint32_t pgRead;
+static uint32_t pgReceived;
+static uint16_t pgRxLast;
+static const uint8_t pgReady = PG_STREAM_READY;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static PG_STATUS_T pgRun(const PG_CONFIG_T*);
+static void pgFill(uint16_t);
+static uint8_t pgNextStep(void);
+static void pgStreamPoll(void);
+
+/******************************************************************************
+* PgLoad - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Receives a pattern of up to PG_MAX_STEPS entries from the
+* 				host into the workspace, after the output buffers.
+*
+* Arguments:    uint16_t num_steps - Number of entries the host will send
+*
+* Return:		Received pattern, 0 if fewer entries arrived
+******************************************************************************/
+const uint32_t *PgLoad(uint16_t num_steps)
+{
+	uint32_t *steps = Workspace + (2U * PG_PLAY_SAMPLES);
+	uint16_t len = num_steps * sizeof(uint32_t);
+
+	if((num_steps == 0U) || (num_steps > PG_MAX_STEPS)) return 0;
+	if(Usart1Read(steps, len, PG_LOAD_TIMEOUT_MS) != len) return 0;
+	return steps;
+}
+
+/******************************************************************************
+* PgPlay - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Receive DMA stopped before playback.
+*
+* Description:  Plays a pattern out of the socket pins, looping as set by
+* 				the config. A pattern entry with PG_END_FLAG ends it early.
+* 				USART1 receive DMA is stopped, as it would take the host
+* 				byte that stops playback before it is seen. The command
+* 				ring must be restarted afterwards (CommandInit).
+*
+* Arguments:    const PG_CONFIG_T *config - Playback settings
+*
+* 				const uint32_t *steps - Pattern entries
+*
+* 				uint16_t num_steps - Number of entries
+*
+* Return:		Reason playback ended
+******************************************************************************/
+PG_STATUS_T PgPlay(const PG_CONFIG_T *config, const uint32_t *steps, uint16_t num_steps)
+{
+	if(num_steps == 0U) return PG_DONE;
+
+	pgStreaming = 0U;
+	pgSteps = steps;
+	pgNumSteps = num_steps;
+	pgIndex = 0U;
+	pgLoops = config->loops;
+
+	// A host byte left over from before would stop playback at once
+	Usart1RxStop();
+	while(USART1->ISR & USART_ISR_RXNE) (void)USART1->RDR;
+	return pgRun(config);
+}
+
+/******************************************************************************
+* PgStream - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Plays a pattern streamed from the host over USART1 until an
+* 				entry with PG_END_FLAG. The device sends PG_STREAM_READY
+* 				whenever the host may send the next PG_STREAM_CHUNK
+* 				entries, two are sent at the start. Playback starts once
+* 				the first chunk is in, and ends with PG_UNDERRUN if the
+* 				host falls behind.
+*
+* Arguments:    const PG_CONFIG_T *config - Playback settings
+*
+* Return:		Reason playback ended
+******************************************************************************/
+PG_STATUS_T PgStream(const PG_CONFIG_T *config)
+{
+	uint32_t start_ms = SysTickGetMS();
+	PG_STATUS_T status;
+
+	pgStreaming = TRUE;
+	pgRing = Workspace + (2U * PG_PLAY_SAMPLES);
+	pgRead = 0U;
+	pgReceived = 0U;
+	pgRxLast = 0U;
+
+	Usart1RxStart(pgRing, PG_STREAM_ENTRIES * sizeof(uint32_t), TRUE);
+	Usart1Write(&pgReady, 1U);
+	Usart1Write(&pgReady, 1U);
+
+	while((pgReceived < (PG_STREAM_CHUNK * sizeof(uint32_t))) && ((SysTickGetMS() - start_ms) < PG_STREAM_TIMEOUT_MS)){
+		pgStreamPoll();
+	}
+
+	status = (pgReceived != 0U) ? pgRun(config) : PG_UNDERRUN;
+	Usart1RxStop();
+	return status;
+}
+
+/******************************************************************************
+* pgRun - Private Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Underrun tested on the flag of the other half, which
+* 				sets as soon as DMA wraps into the half being refilled.
+*
+* Description:  Primes both halves of the output buffer, starts TIM1 and
+* 				refills each half as DMA finishes playing it. Once the
+* 				pattern has ended the half holding its last step is
+* 				allowed to play out, then the socket is floated.
+*
+* Arguments:    const PG_CONFIG_T *config - Playback settings
+*
+* Return:		Reason playback ended
+******************************************************************************/
+static PG_STATUS_T pgRun(const PG_CONFIG_T *config)
+{
+	uint32_t rate_hz = (config->rate_hz > PG_MAX_RATE_HZ) ? PG_MAX_RATE_HZ : config->rate_hz;
+	uint32_t period = PG_TIM_CLK_HZ / ((rate_hz != 0U) ? rate_hz : 1U);
+	uint32_t prescale = period >> 16;
+	uint32_t half_flag;
+	uint16_t first;
+	uint8_t drain = 0U;
+
+	pgPlayA = Workspace;
+	pgPlayB = Workspace + PG_PLAY_SAMPLES;
+	pgDriveMask = 0U;
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(config->drive_pins & (1U << ic_pin)) pgDriveMask |= SocketPinMask[ic_pin];
+	}
+	pgBsrrA = 0U;
+	pgBsrrB = 0U;
+	pgRemain = 0U;
+	pgEnded = 0U;
+	pgStatus = PG_DONE;
+
+	pgFill(0U);
+	pgFill(PG_HALF);
+
+	SocketFloat();
+	SocketSetOutputs(pgDriveMask);
+
+	DMA1_Channel2->CCR = 0U;
+	DMA1_Channel2->CPAR = (uint32_t)&GPIOA->BSRR;
+	DMA1_Channel2->CMAR = (uint32_t)pgPlayA;
+	DMA1_Channel2->CNDTR = PG_PLAY_SAMPLES;
+	DMA1_Channel2->CCR = DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_DIR | DMA_CCR_EN;
+
+	DMA1_Channel3->CCR = 0U;
+	DMA1_Channel3->CPAR = (uint32_t)&GPIOB->BSRR;
+	DMA1_Channel3->CMAR = (uint32_t)pgPlayB;
+	DMA1_Channel3->CNDTR = PG_PLAY_SAMPLES;
+	DMA1_Channel3->CCR = DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_DIR | DMA_CCR_EN;
+
+	DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3;
+
+	TIM1->CR1 = 0U;
+	TIM1->PSC = prescale;
+	TIM1->ARR = (period / (prescale + 1U)) - 1U;
+	TIM1->CCR1 = PG_OUTPUT_COMPARE;
+	TIM1->CCR2 = PG_OUTPUT_COMPARE;
+	TIM1->EGR = TIM_EGR_UG;
+	TIM1->SR = 0U;
+	TIM1->DIER = TIM_DIER_CC1DE | TIM_DIER_CC2DE;
+	TIM1->CR1 = TIM_CR1_CEN;
+
+	// Channel 3 is served after channel 2 for the same step, so its flags
+	// mark when both ports of a half have been played
+	first = 0U;
+	while(1){
+		half_flag = (first == 0U) ? DMA_ISR_HTIF3 : DMA_ISR_TCIF3;
+		while((DMA1->ISR & half_flag) == 0U){
+			if((pgStreaming != TRUE) && (USART1->ISR & USART_ISR_RXNE)){
+				(void)USART1->RDR;
+				pgStatus = PG_STOPPED;
+				break;
+			}
+		}
+		if(pgStatus == PG_STOPPED) break;
+		DMA1->IFCR = half_flag;
+
+		// The last step is in the half refilled two flags ago
+		if(pgEnded == TRUE){
+			if(++drain == 2U) break;
+		}
+		pgFill(first);
+
+		// DMA finished the other half and wrapped into this one before the
+		// refill was done, so stale steps were played. The flag of this
+		// half would only set once the whole half had been played again.
+		if(DMA1->ISR & ((first == 0U) ? DMA_ISR_TCIF3 : DMA_ISR_HTIF3)){
+			pgStatus = PG_UNDERRUN;
+			break;
+		}
+		first ^= PG_HALF;
+	}
+
+	TIM1->CR1 = 0U;
+	TIM1->DIER = 0U;
+	DMA1_Channel2->CCR = 0U;
+	DMA1_Channel3->CCR = 0U;
+	SocketFloat();
+
+	return pgStatus;
+}
+
+/******************************************************************************
+* pgFill - Private Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Expands pattern entries into one half of the output buffer.
+* 				Once the pattern has ended the last step is held.
+*
+* Arguments:    uint16_t first - First output sample of the half
+*
+* Return:		None
+******************************************************************************/
+static void pgFill(uint16_t first)
+{
+	for(uint16_t index = first; index < (first + PG_HALF); index++){
+		if((pgRemain == 0U) && (pgEnded != TRUE)){
+			if(pgNextStep() != TRUE) pgEnded = TRUE;
+		}
+		pgPlayA[index] = pgBsrrA;
+		pgPlayB[index] = pgBsrrB;
+		if(pgRemain != 0U) pgRemain--;
+	}
+}
+
+/******************************************************************************
+* pgNextStep - Private Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Fetches the next pattern entry, from the host ring or from
+* 				RAM with looping, and converts it into BSRR words for the
+* 				driven pins.
+*
+* Arguments:    None
+*
+* Return:		1 if a step was loaded, 0 if the pattern has ended
+******************************************************************************/
+static uint8_t pgNextStep(void)
+{
+	uint32_t entry;
+	uint32_t word;
+
+	if(pgStreaming == TRUE){
+		pgStreamPoll();
+		if((pgReceived / sizeof(uint32_t)) <= pgRead){
+			pgStatus = PG_UNDERRUN;
+			return 0U;
+		}
+		entry = pgRing[pgRead % PG_STREAM_ENTRIES];
+		pgRead++;
+		if((pgRead % PG_STREAM_CHUNK) == 0U) Usart1Write(&pgReady, 1U);
+	} else {
+		if(pgIndex == pgNumSteps){
+			if(pgLoops == 1U) return 0U;
+			if(pgLoops != 0U) pgLoops--;
+			pgIndex = 0U;
+		}
+		entry = pgSteps[pgIndex++];
+	}
+
+	if(entry & PG_END_FLAG) return 0U;
+
+	word = LA_UNPACK(entry);
+	pgBsrrA = SOCKET_BSRR_A(word, pgDriveMask);
+	pgBsrrB = SOCKET_BSRR_B(word, pgDriveMask);
+	pgRemain = (entry >> LA_RUN_SHIFT) + 1U;
+	return TRUE;
+}
+
+/******************************************************************************
+* pgStreamPoll - Private Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Adds the bytes the receive DMA has written to the ring since
+* 				the last poll to the received total. The host only sends
+* 				a chunk once its slot is free, so the ring cannot lap a
+* 				poll.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void pgStreamPoll(void)
+{
+	uint16_t pos = Usart1RxPos();
+
+	pgReceived += (uint16_t)(pos - pgRxLast + (PG_STREAM_ENTRIES * sizeof(uint32_t))) % (PG_STREAM_ENTRIES * sizeof(uint32_t));
+	pgRxLast = pos;
+}
@@ -0,0 +1,108 @@
+/******************************************************************************
+* 	PatternGen.h
+*
+* 	Header for PatternGen.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/15/2019:
+* 	Created pattern generator with looped and host streamed playback.
+*
+* 	Created on: 08/15/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef PATTERNGEN_H_
+#define PATTERNGEN_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define PG_MAX_RATE_HZ 1000000U
+// Highest step rate. Each step costs two DMA transfers and ~12 SYSCLK
+// cycles of expansion.
+
+#define PG_MAX_STEPS 512U
+// Longest pattern held in the workspace by PgLoad
+
+#define PG_END_FLAG 0x00000001U
+// Pattern entries use the logic analyzer RLE format (LA_RUN_SHIFT), so a
+// capture can be played back as is. Analyzer word bit 0 is never a socket
+// pin, an entry with it set ends the pattern.
+
+#define PG_STREAM_READY 0x52U
+// "R", sent to the host each time it may send PG_STREAM_CHUNK more entries
+
+#define PG_STREAM_CHUNK 128U
+
+typedef struct {
+	uint32_t rate_hz;
+	uint16_t drive_pins;
+	uint16_t loops;
+} PG_CONFIG_T;
+// Playback settings: step rate, IC pins driven (bit n = IC pin n, others
+// float) and times to play the pattern (0 repeats until a byte arrives
+// from the host, ignored when streaming)
+
+typedef enum {PG_DONE,
+			  PG_STOPPED,
+			  PG_UNDERRUN
+} PG_STATUS_T;
+// Playback ended at the end of the pattern, on a host byte, or because the
+// output buffer (or host stream) was not refilled in time
+
+/******************************************************************************
+* PgLoad - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Receives a pattern of up to PG_MAX_STEPS entries from the
+* 				host into the workspace.
+*
+* Arguments:    uint16_t num_steps - Number of entries the host will send
+*
+* Return:		Received pattern, 0 if fewer entries arrived
+******************************************************************************/
+const uint32_t *PgLoad(uint16_t);
+
+/******************************************************************************
+* PgPlay - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Receive DMA stopped before playback.
+*
+* Description:  Plays a pattern out of the socket pins, looping as set by
+* 				the config. Stops USART1 receive DMA so a host byte can
+* 				stop playback, the command ring must be restarted after.
+*
+* Arguments:    const PG_CONFIG_T *config - Playback settings
+*
+* 				const uint32_t *steps - Pattern entries
+*
+* 				uint16_t num_steps - Number of entries
+*
+* Return:		Reason playback ended
+******************************************************************************/
+PG_STATUS_T PgPlay(const PG_CONFIG_T*, const uint32_t*, uint16_t);
+
+/******************************************************************************
+* PgStream - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Plays a pattern streamed from the host over USART1 until an
+* 				entry with PG_END_FLAG. The device sends PG_STREAM_READY
+* 				whenever the host may send the next PG_STREAM_CHUNK
+* 				entries, two are sent at the start.
+*
+* Arguments:    const PG_CONFIG_T *config - Playback settings
+*
+* Return:		Reason playback ended
+******************************************************************************/
+PG_STATUS_T PgStream(const PG_CONFIG_T*);
+
+#endif /* PATTERNGEN_H_ */
@@ -0,0 +1,162 @@
+/******************************************************************************
+* 	Profile.c
+*
+* 	This source file times the stages of the checker hot path, so the
+* 	split of test time between pin setup, drive, settle, read and compare
+* 	can be seen without a profiler. Stages are timed from the free-running
+* 	timestamp timer and accumulated in RAM for the IC type under test, read
+* 	over USART1 (CMD_PROFILE). Only built in the Debug configuration
+* 	(CHECKER_PROFILE), release builds keep none of it.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/29/2019:
+* 	Created per-stage timing counters for the test engine.
+*
+* 	08/31/2019:
+* 	Counters kept for the IC type under test only (832 to 46 bytes of RAM),
+* 	the Debug build did not fit in RAM with a set per IC type.
+*
+* 	Created on: 08/29/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Checker.h"
+#include "Profile.h"
+
+#ifdef CHECKER_PROFILE
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+typedef struct {
+	uint32_t total_cycles[PROFILE_NUM_STAGES];
+	uint16_t count[PROFILE_NUM_STAGES];
+	uint16_t max_cycles[PROFILE_NUM_STAGES];
+} PROFILE_COUNTERS_T;
+// Counters of every stage of one IC type, kept as arrays to avoid padding.
+// A stage stops accumulating once its count saturates, so total/count stays
+// the mean.
+
+#define PROFILE_COUNT_MAX 0xFFFFU
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static PROFILE_COUNTERS_T profileCounters;
+static IC_DESIGNATOR_T profileDesignator;
+static uint16_t profileMark;
+
+/******************************************************************************
+* ProfileMark - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts timing the next stage.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void ProfileMark(void)
+{
+	profileMark = TIMESTAMP_NOW();
+}
+
+/******************************************************************************
+* ProfileStage - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Counters cleared when the IC type changes.
+*
+* Description:  Adds the cycles since the last mark or stage to a stage of
+* 				an IC type, then starts timing the next stage. A different
+* 				IC type from the one being profiled clears every counter
+* 				first. The next stage starts after the counters are
+* 				updated, so the time taken here is not charged to any
+* 				stage. Stages must be shorter than the timestamp wrap
+* 				(~1.36ms).
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC type being tested
+*
+* 				PROFILE_STAGE_T stage - Stage that just ended
+*
+* Return:		None
+******************************************************************************/
+void ProfileStage(IC_DESIGNATOR_T ic_designator, PROFILE_STAGE_T stage)
+{
+	uint16_t cycles = (uint16_t)(TIMESTAMP_NOW() - profileMark);
+
+	if(ic_designator != profileDesignator){
+		ProfileClear();
+		profileDesignator = ic_designator;
+	}
+
+	if(profileCounters.count[stage] < PROFILE_COUNT_MAX){
+		profileCounters.total_cycles[stage] += cycles;
+		profileCounters.count[stage]++;
+	}
+	if(cycles > profileCounters.max_cycles[stage]) profileCounters.max_cycles[stage] = cycles;
+
+	profileMark = TIMESTAMP_NOW();
+}
+
+/******************************************************************************
+* ProfileGet - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Only the IC type under test has counters.
+*
+* Description:  Reads the counters of one stage of an IC type. An IC type
+* 				other than the last one tested reads as zeros.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC type
+*
+* 				PROFILE_STAGE_T stage - Stage
+*
+* 				PROFILE_STATS_T *stats - Filled in with the counters
+*
+* Return:		None
+******************************************************************************/
+void ProfileGet(IC_DESIGNATOR_T ic_designator, PROFILE_STAGE_T stage, PROFILE_STATS_T *stats)
+{
+	stage %= PROFILE_NUM_STAGES;
+	if(ic_designator != profileDesignator){
+		stats->total_cycles = 0U;
+		stats->count = 0U;
+		stats->max_cycles = 0U;
+		return;
+	}
+	stats->total_cycles = profileCounters.total_cycles[stage];
+	stats->count = profileCounters.count[stage];
+	stats->max_cycles = profileCounters.max_cycles[stage];
+}
+
+/******************************************************************************
+* ProfileClear - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears the counters of every stage.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void ProfileClear(void)
+{
+	for(uint8_t stage = 0; stage < PROFILE_NUM_STAGES; stage++){
+		profileCounters.total_cycles[stage] = 0U;
+		profileCounters.count[stage] = 0U;
+		profileCounters.max_cycles[stage] = 0U;
+	}
+}
+#endif
@@ -0,0 +1,129 @@
+/******************************************************************************
+* 	Profile.h
+*
+* 	Header for Profile.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/29/2019:
+* 	Created per-stage timing counters for the test engine.
+*
+* 	08/31/2019:
+* 	Counters kept for the IC type under test only.
+*
+* 	Created on: 08/29/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+typedef enum {PROFILE_SETUP,
+			  PROFILE_DRIVE,
+			  PROFILE_SETTLE,
+			  PROFILE_READ,
+			  PROFILE_COMPARE
+} PROFILE_STAGE_T;
+// Stages of a program run timed: pin setup before the first vector, input
+// write, settle wait, output read, and compare (including any vote, or the
+// CRC feed in signature mode)
+
+#define PROFILE_NUM_STAGES 5U
+
+typedef struct {
+	uint32_t total_cycles;
+	uint32_t count;
+	uint16_t max_cycles;
+} PROFILE_STATS_T;
+// Time spent in one stage for one IC type since the last clear (or since
+// that IC type was last switched to): total and longest SYSCLK cycles, and
+// number of times timed
+
+#ifdef CHECKER_PROFILE
+#define PROFILE_MARK() ProfileMark()
+#define PROFILE_STAGE(ic_designator, stage) ProfileStage((ic_designator), (stage))
+#else
+#define PROFILE_MARK()
+#define PROFILE_STAGE(ic_designator, stage)
+#endif
+// Instrumentation points. A stage is timed from the previous mark or stage.
+// Only built with CHECKER_PROFILE defined (Debug configuration), otherwise
+// they compile to nothing.
+
+#ifdef CHECKER_PROFILE
+/******************************************************************************
+* ProfileMark - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts timing the next stage.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void ProfileMark(void);
+
+/******************************************************************************
+* ProfileStage - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Counters cleared when the IC type changes.
+*
+* Description:  Adds the cycles since the last mark or stage to a stage of
+* 				an IC type, then starts timing the next stage. Only one
+* 				IC type is profiled at a time, a different one clears
+* 				every counter first.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC type being tested
+*
+* 				PROFILE_STAGE_T stage - Stage that just ended
+*
+* Return:		None
+******************************************************************************/
+void ProfileStage(IC_DESIGNATOR_T, PROFILE_STAGE_T);
+
+/******************************************************************************
+* ProfileGet - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Only the IC type under test has counters.
+*
+* Description:  Reads the counters of one stage of an IC type. An IC type
+* 				other than the last one tested reads as zeros.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - IC type
+*
+* 				PROFILE_STAGE_T stage - Stage
+*
+* 				PROFILE_STATS_T *stats - Filled in with the counters
+*
+* Return:		None
+******************************************************************************/
+void ProfileGet(IC_DESIGNATOR_T, PROFILE_STAGE_T, PROFILE_STATS_T*);
+
+/******************************************************************************
+* ProfileClear - Public Function
+*
+* 08/29/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Clears the counters of every stage.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void ProfileClear(void);
+#endif
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,315 @@
+/******************************************************************************
+* 	SelfTest.c
+*
+* 	This source file contains the power-up fixture self-test. With the socket
+* 	empty, every socket pin is driven and read back, checked for pull-up and
+* 	pull-down response, checked for bridges to other socket pins, and timed
+* 	while rising under the internal pull-up. Per-pin rise time offsets are
+* 	kept in the flash calibration page so the checker settle time can
+* 	compensate for slow contacts. Dependent on TIM6 timestamp counter.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/06/2019:
+* 	Created power-up fixture self-test and socket pin timing calibration.
+*
+* 	Created on: 08/06/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "SysTick.h"
+#include "Timestamp.h"
+#include "Flash.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "SelfTest.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define SELFTEST_PULL_WAIT 96U
+// 2us for a pin to follow its driver or internal pull (socket empty)
+
+#define SELFTEST_RISE_SAMPLES 8U
+// Rise time measurements averaged per pin
+
+#define SELFTEST_RISE_TIMEOUT 4800U
+// 100us, rise time measurement abandoned
+
+#define SELFTEST_RISE_LIMIT 480U
+// 10us, an empty socket pin slower than this is a fixture fault
+
+#define SELFTEST_OFFSET_TOLERANCE 4U
+// Offsets differing from flash by no more than this are not rewritten,
+// avoiding a page erase on every power-up
+
+#define SELFTEST_CAL_MAGIC 0xCA1BU
+
+typedef struct {
+	uint16_t magic;
+	uint16_t offset_cycles[SOCKET_NUM_PINS + 1];
+} SELFTEST_CAL_T;
+// Calibration record as stored at the start of FLASH_CAL_PAGE
+
+#define SELFTEST_CAL ((const SELFTEST_CAL_T *)FLASH_CAL_PAGE)
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static SELFTEST_RESULT_T selftestResult;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint8_t selftestCheckPin(uint8_t);
+static uint16_t selftestRiseTime(uint8_t);
+static void selftestWait(uint16_t);
+static uint8_t selftestStoreCal(void);
+
+/******************************************************************************
+* SelfTestRun - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Checks every routed socket pin with the socket empty: drive
+* 				high/low readback, pull-up/pull-down response, bridging to
+* 				any other socket pin, and rise time from low under the
+* 				internal pull-up (TIM6 timed). Rise time differences between
+* 				pins become settle time offsets, which are stored to flash
+* 				when they have changed and handed to the checker. If any pin
+* 				fails, the last stored calibration is kept. Intended to run
+* 				once at power-up, completes in about 1ms (plus one page
+* 				erase when calibration changes).
+*
+* Arguments:    None
+*
+* Return:		Bit field of failed IC pins (0 = fixture good)
+******************************************************************************/
+uint16_t SelfTestRun(void)
+{
+	uint32_t start_ms = SysTickGetMS();
+	uint16_t min_rise = 0xFFFFU;
+	uint8_t ic_pin;
+
+	selftestResult.failed_pins = 0U;
+	selftestResult.cal_stored = 0U;
+
+	for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		selftestResult.fail_flags[ic_pin] = 0U;
+		selftestResult.rise_cycles[ic_pin] = 0U;
+		selftestResult.offset_cycles[ic_pin] = 0U;
+		if(SocketPinMask[ic_pin] == 0U) continue;
+
+		selftestResult.fail_flags[ic_pin] = selftestCheckPin(ic_pin);
+		selftestResult.rise_cycles[ic_pin] = selftestRiseTime(ic_pin);
+
+		if(selftestResult.rise_cycles[ic_pin] > SELFTEST_RISE_LIMIT){
+			selftestResult.fail_flags[ic_pin] |= SELFTEST_FAIL_RISE;
+		}
+		if(selftestResult.fail_flags[ic_pin] != 0U){
+			selftestResult.failed_pins |= (1U << ic_pin);
+		} else if(selftestResult.rise_cycles[ic_pin] < min_rise){
+			min_rise = selftestResult.rise_cycles[ic_pin];
+		}
+	}
+	SocketFloat();
+
+	if(selftestResult.failed_pins == 0U){
+		// Offsets are relative to the fastest pin
+		for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+			if(SocketPinMask[ic_pin] == 0U) continue;
+			selftestResult.offset_cycles[ic_pin] = selftestResult.rise_cycles[ic_pin] - min_rise;
+		}
+		selftestResult.cal_stored = selftestStoreCal();
+	} else if(SELFTEST_CAL->magic == SELFTEST_CAL_MAGIC){
+		// Fixture fault, keep last good calibration
+		for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+			selftestResult.offset_cycles[ic_pin] = SELFTEST_CAL->offset_cycles[ic_pin];
+		}
+	}
+
+	for(ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		CheckerSetSettleOffset(ic_pin, selftestResult.offset_cycles[ic_pin]);
+	}
+
+	selftestResult.duration_ms = SysTickGetMS() - start_ms;
+	return selftestResult.failed_pins;
+}
+
+/******************************************************************************
+* SelfTestGetResult - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the result of the last self-test.
+*
+* Arguments:    None
+*
+* Return:		Pointer to self-test result
+******************************************************************************/
+const SELFTEST_RESULT_T *SelfTestGetResult(void)
+{
+	return &selftestResult;
+}
+
+/******************************************************************************
+* selftestCheckPin - Private Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Drives the pin high while every other socket pin is pulled
+* 				down, then low while every other pin is pulled up. The pin
+* 				must follow its driver and no other pin may follow it
+* 				(bridge). The pin is then released and must follow its own
+* 				pull-up and pull-down.
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* Return:		Failure flags for pin (0 = pin good)
+******************************************************************************/
+static uint8_t selftestCheckPin(uint8_t ic_pin)
+{
+	uint32_t pin_mask = SocketPinMask[ic_pin];
+	uint32_t other_mask = SOCKET_ALL_MASK & ~pin_mask;
+	uint32_t read;
+	uint8_t fail_flags = 0U;
+
+	SocketFloat();
+
+	// Drive high, others pulled down
+	SocketSetPull(other_mask, SOCKET_PULL_DOWN);
+	SOCKET_WRITE(pin_mask, pin_mask);
+	SocketSetOutputs(pin_mask);
+	selftestWait(SELFTEST_PULL_WAIT);
+	read = SOCKET_READ();
+	if((read & pin_mask) == 0U) fail_flags |= SELFTEST_FAIL_DRIVE_HIGH;
+	if((read & other_mask) != 0U) fail_flags |= SELFTEST_FAIL_BRIDGE;
+
+	// Drive low, others pulled up
+	SocketSetPull(other_mask, SOCKET_PULL_UP);
+	SOCKET_WRITE(0U, pin_mask);
+	selftestWait(SELFTEST_PULL_WAIT);
+	read = SOCKET_READ();
+	if((read & pin_mask) != 0U) fail_flags |= SELFTEST_FAIL_DRIVE_LOW;
+	if((read & other_mask) != other_mask) fail_flags |= SELFTEST_FAIL_BRIDGE;
+
+	// Released, must follow internal pulls
+	SocketSetPull(other_mask, SOCKET_PULL_NONE);
+	SocketSetInputs(pin_mask);
+	SocketSetPull(pin_mask, SOCKET_PULL_UP);
+	selftestWait(SELFTEST_PULL_WAIT);
+	if((SOCKET_READ() & pin_mask) == 0U) fail_flags |= SELFTEST_FAIL_PULL_UP;
+
+	SocketSetPull(pin_mask, SOCKET_PULL_DOWN);
+	selftestWait(SELFTEST_PULL_WAIT);
+	if((SOCKET_READ() & pin_mask) != 0U) fail_flags |= SELFTEST_FAIL_PULL_DOWN;
+
+	SocketSetPull(pin_mask, SOCKET_PULL_NONE);
+	return fail_flags;
+}
+
+/******************************************************************************
+* selftestRiseTime - Private Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Discharges the pin by driving it low, then switches it to
+* 				input with pull-up and counts TIM6 cycles until it reads
+* 				high. The mode change is a single MODER write so loop
+* 				overhead is the same for every pin. Averaged over
+* 				SELFTEST_RISE_SAMPLES measurements.
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* Return:		Average rise time in SYSCLK cycles (SELFTEST_RISE_TIMEOUT
+* 				if the pin never rose)
+******************************************************************************/
+static uint16_t selftestRiseTime(uint8_t ic_pin)
+{
+	uint32_t pin_mask = SocketPinMask[ic_pin];
+	uint8_t bit;
+	GPIO_TypeDef *port = SocketPinPort(ic_pin, &bit);
+	uint32_t moder_input = port->MODER & ~(0x3U << (bit * 2));
+	uint32_t total_cycles = 0U;
+	uint16_t start_time;
+	uint16_t elapsed;
+
+	for(uint8_t sample = 0; sample < SELFTEST_RISE_SAMPLES; sample++){
+		SocketSetPull(pin_mask, SOCKET_PULL_UP);
+		SOCKET_WRITE(0U, pin_mask);
+		SocketSetOutputs(pin_mask);
+		selftestWait(SELFTEST_PULL_WAIT);
+
+		start_time = TIMESTAMP_NOW();
+		port->MODER = moder_input;
+		do{
+			elapsed = (uint16_t)(TIMESTAMP_NOW() - start_time);
+		} while(((port->IDR & (1U << bit)) == 0U) && (elapsed < SELFTEST_RISE_TIMEOUT));
+
+		total_cycles += elapsed;
+	}
+	SocketSetPull(pin_mask, SOCKET_PULL_NONE);
+
+	return (uint16_t)(total_cycles / SELFTEST_RISE_SAMPLES);
+}
+
+/******************************************************************************
+* selftestWait - Private Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Busy waits on the TIM6 timestamp counter.
+*
+* Arguments:    uint16_t cycles - Wait length in SYSCLK cycles
+*
+* Return:		None
+******************************************************************************/
+static void selftestWait(uint16_t cycles)
+{
+	uint16_t start_time = TIMESTAMP_NOW();
+
+	while((uint16_t)(TIMESTAMP_NOW() - start_time) < cycles){}
+}
+
+/******************************************************************************
+* selftestStoreCal - Private Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Compares the measured offsets with the calibration page
+* 				and rewrites it only if it is blank or any offset moved by
+* 				more than SELFTEST_OFFSET_TOLERANCE, limiting flash wear.
+*
+* Arguments:    None
+*
+* Return:		1 if calibration was written, 0 otherwise
+******************************************************************************/
+static uint8_t selftestStoreCal(void)
+{
+	SELFTEST_CAL_T cal;
+	uint8_t changed = (SELFTEST_CAL->magic != SELFTEST_CAL_MAGIC);
+
+	cal.magic = SELFTEST_CAL_MAGIC;
+	for(uint8_t ic_pin = 0; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		uint16_t stored = SELFTEST_CAL->offset_cycles[ic_pin];
+		uint16_t measured = selftestResult.offset_cycles[ic_pin];
+		uint16_t difference = (measured > stored) ? (measured - stored) : (stored - measured);
+
+		cal.offset_cycles[ic_pin] = measured;
+		if(difference > SELFTEST_OFFSET_TOLERANCE){
+			changed = 1U;
+		}
+	}
+
+	if(changed == 0U) return 0U;
+
+	if(FlashErasePage(FLASH_CAL_PAGE) != FLASH_OK) return 0U;
+	if(FlashProgram(FLASH_CAL_PAGE, (const uint16_t *)&cal, sizeof(cal) / 2U) != FLASH_OK) return 0U;
+	return 1U;
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+* 	SelfTest.h
+*
+* 	Header for SelfTest.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/06/2019:
+* 	Created power-up fixture self-test and socket pin timing calibration.
+*
+* 	Created on: 08/06/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef SELFTEST_H_
+#define SELFTEST_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define SELFTEST_FAIL_DRIVE_HIGH 0x01U
+#define SELFTEST_FAIL_DRIVE_LOW 0x02U
+#define SELFTEST_FAIL_PULL_UP 0x04U
+#define SELFTEST_FAIL_PULL_DOWN 0x08U
+#define SELFTEST_FAIL_BRIDGE 0x10U
+#define SELFTEST_FAIL_RISE 0x20U
+// Per-pin failure flags
+
+typedef struct {
+	uint16_t failed_pins;
+	uint8_t fail_flags[SOCKET_NUM_PINS + 1];
+	uint16_t rise_cycles[SOCKET_NUM_PINS + 1];
+	uint16_t offset_cycles[SOCKET_NUM_PINS + 1];
+	uint8_t cal_stored;
+	uint32_t duration_ms;
+} SELFTEST_RESULT_T;
+// Self-test result: bit field of failed IC pins (bit n = IC pin n), failure
+// flags, measured pull-up rise time and settle offset per pin, whether new
+// calibration was written to flash, and total self-test duration
+
+/******************************************************************************
+* SelfTestRun - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Checks every routed socket pin with the socket empty: drive
+* 				high/low readback, pull-up/pull-down response, bridging to
+* 				any other socket pin, and rise time from low under the
+* 				internal pull-up (TIM6 timed). Rise time differences between
+* 				pins become settle time offsets, which are stored to flash
+* 				when they have changed and handed to the checker. If any pin
+* 				fails, the last stored calibration is kept. Intended to run
+* 				once at power-up, completes in about 1ms (plus one page
+* 				erase when calibration changes).
+*
+* Arguments:    None
+*
+* Return:		Bit field of failed IC pins (0 = fixture good)
+******************************************************************************/
+uint16_t SelfTestRun(void);
+
+/******************************************************************************
+* SelfTestGetResult - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives read access to the result of the last self-test.
+*
+* Arguments:    None
+*
+* Return:		Pointer to self-test result
+******************************************************************************/
+const SELFTEST_RESULT_T *SelfTestGetResult(void);
+
+#endif /* SELFTEST_H_ */
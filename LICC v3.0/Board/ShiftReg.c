@@ -0,0 +1,188 @@
+/******************************************************************************
+* 	ShiftReg.c
+*
+* 	This source file tests serial-in parallel-out shift registers such as the
+* 	74HC164. The serial data and clock are streamed to the socket with
+* 	single port-wide BSRR writes and every parallel output is read back with
+* 	a single port-wide read after each clock edge, compared against a model
+* 	of the register. The SPI peripherals are not used as SPI1 SCK/MOSI land
+* 	on socket pins 9 and 6, which are not the clock and data pins of any 14
+* 	pin shift register. Dependent on the TIM6 timestamp counter.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/11/2019:
+* 	Created serial-in parallel-out shift register test.
+*
+* 	08/30/2019:
+* 	Edges spaced by the IC settle time from the checker instead of a fixed
+* 	500ns.
+*
+* 	08/31/2019:
+* 	Test abandoned as soon as an over-current floats the socket.
+*
+* 	Created on: 08/11/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "OverCurrent.h"
+#include "ShiftReg.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+#define FAILED 0U
+
+#define SHIFT_MAX_STAGES 8U
+// Most parallel outputs of a 14 pin shift register
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint32_t shiftRegExpected(uint8_t, const uint32_t*, uint8_t);
+static void shiftRegSettle(uint16_t);
+
+/******************************************************************************
+* ShiftRegTest - Public Function
+*
+* 08/11/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Edges spaced by the IC settle time.
+*
+* 08/31/2019:	Anthony Needles
+* 				Over-current checked after every clock.
+*
+* Description:  Tests a serial-in parallel-out shift register. The master
+* 				reset is checked, SHIFT_PATTERN is then clocked in with
+* 				every parallel output compared port-wide after every clock
+* 				edge, and finally the reset is checked again with every
+* 				stage loaded. Zeros are shifted in with each of the three
+* 				low combinations of the two data inputs in turn so the
+* 				data gate is covered as well. Every edge is followed by
+* 				the settle time the checker uses for the IC (see
+* 				CheckerGetSettle), so slow socket pins found by fixture
+* 				calibration are waited for. The test stops at the first
+* 				clock after an over-current has floated the socket.
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint8_t *fail_step - Failing step (0 first reset, n clock
+* 				edge n, SHIFT_NUM_CLOCKS + 1 final reset)
+*
+* Return:		Test pass or test failure
+******************************************************************************/
+uint8_t ShiftRegTest(const IC_PARAMETERS_T *IC, uint8_t *fail_step)
+{
+	uint32_t stage_mask[SHIFT_MAX_STAGES];
+	uint32_t dsa_mask = SocketPinMask[IC->input_pins[SHIFT_PIN_DSA]];
+	uint32_t dsb_mask = SocketPinMask[IC->input_pins[SHIFT_PIN_DSB]];
+	uint32_t cp_mask = SocketPinMask[IC->input_pins[SHIFT_PIN_CP]];
+	uint32_t mr_mask = SocketPinMask[IC->input_pins[SHIFT_PIN_MR]];
+	uint32_t in_mask = dsa_mask | dsb_mask | cp_mask | mr_mask;
+	uint32_t out_mask = 0U;
+	uint8_t num_stages = (IC->num_outputs < SHIFT_MAX_STAGES) ? IC->num_outputs : SHIFT_MAX_STAGES;
+	uint16_t settle_cycles = CheckerGetSettle(IC);
+	uint8_t stage_reg = 0U;
+	uint8_t zero_count = 0U;
+	uint32_t data;
+	uint8_t clock;
+
+	for(uint8_t stage = 0; stage < num_stages; stage++){
+		stage_mask[stage] = SocketPinMask[IC->output_pins[stage]];
+		out_mask |= stage_mask[stage];
+	}
+
+	// Reset asserted with everything else low
+	SOCKET_WRITE(0U, in_mask);
+	SocketSetOutputs(in_mask);
+	SocketSetInputs(out_mask);
+	shiftRegSettle(settle_cycles);
+	*fail_step = 0U;
+	if(SOCKET_READ() & out_mask) return FAILED;
+
+	SOCKET_WRITE(mr_mask, mr_mask);
+
+	for(clock = 0; clock < SHIFT_NUM_CLOCKS; clock++){
+		if((SHIFT_PATTERN >> clock) & 1U){
+			data = dsa_mask | dsb_mask;
+			stage_reg = (stage_reg << 1) | 1U;
+		} else {
+			data = (zero_count == 0U) ? dsb_mask : (zero_count == 1U) ? dsa_mask : 0U;
+			zero_count = (zero_count + 1U) % 3U;
+			stage_reg <<= 1;
+		}
+
+		// Data changes with clock low, then rising edge
+		SOCKET_WRITE(data, dsa_mask | dsb_mask | cp_mask);
+		shiftRegSettle(settle_cycles);
+		SOCKET_WRITE(cp_mask, cp_mask);
+		shiftRegSettle(settle_cycles);
+
+		*fail_step = clock + 1U;
+		if(OcTripped() == TRUE) return FAILED;
+		if((SOCKET_READ() & out_mask) != shiftRegExpected(stage_reg, stage_mask, num_stages)) return FAILED;
+	}
+
+	// Asynchronous reset with stages loaded and clock held high
+	SOCKET_WRITE(0U, mr_mask);
+	shiftRegSettle(settle_cycles);
+	*fail_step = SHIFT_NUM_CLOCKS + 1U;
+	if(SOCKET_READ() & out_mask) return FAILED;
+
+	return PASSED;
+}
+
+/******************************************************************************
+* shiftRegExpected - Private Function
+*
+* 08/11/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts the modeled register contents into the packed
+* 				socket word expected on the parallel outputs.
+*
+* Arguments:    uint8_t stage_reg - Register model (bit n = Qn)
+*
+* 				const uint32_t *stage_mask - Socket mask of each output
+*
+* 				uint8_t num_stages - Number of outputs
+*
+* Return:		Expected packed socket word
+******************************************************************************/
+static uint32_t shiftRegExpected(uint8_t stage_reg, const uint32_t *stage_mask, uint8_t num_stages)
+{
+	uint32_t expected = 0U;
+
+	for(uint8_t stage = 0; stage < num_stages; stage++){
+		if(stage_reg & (1U << stage)) expected |= stage_mask[stage];
+	}
+	return expected;
+}
+
+/******************************************************************************
+* shiftRegSettle - Private Function
+*
+* 08/11/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Wait passed in.
+*
+* Description:  Waits on the timestamp counter.
+*
+* Arguments:    uint16_t cycles - SYSCLK cycles to wait
+*
+* Return:		None
+******************************************************************************/
+static void shiftRegSettle(uint16_t cycles)
+{
+	uint16_t start = TIMESTAMP_NOW();
+
+	while((uint16_t)(TIMESTAMP_NOW() - start) < cycles){}
+}
@@ -0,0 +1,66 @@
+/******************************************************************************
+* 	ShiftReg.h
+*
+* 	Header for ShiftReg.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/11/2019:
+* 	Created serial-in parallel-out shift register test.
+*
+* 	08/30/2019:
+* 	Settle time taken from the checker (CYCLES_DELAY, drive profile and
+* 	calibration offsets).
+*
+* 	Created on: 08/11/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef SHIFTREG_H_
+#define SHIFTREG_H_
+
+#include "Checker.h"
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define SHIFT_PIN_DSA 0U
+#define SHIFT_PIN_DSB 1U
+#define SHIFT_PIN_CP 2U
+#define SHIFT_PIN_MR 3U
+// Roles of the IC input_pins entries for IC_CLASS_SHIFT_REGISTER: serial
+// data inputs A and B (data shifted in is A AND B), rising edge clock, and
+// active low master reset. output_pins holds Q0 onwards.
+
+#define SHIFT_NUM_CLOCKS 64U
+// Clock edges in the shift pattern
+
+#define SHIFT_PATTERN 0x963F86655003FEFFULL
+// Serial data, LSB shifted first: eight ones then a walking zero, a walking
+// one, alternating bits, bit pairs, nibbles and a mixed tail
+
+/******************************************************************************
+* ShiftRegTest - Public Function
+*
+* 08/11/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/30/2019:	Anthony Needles
+* 				Edges spaced by the IC settle time.
+*
+* Description:  Tests a serial-in parallel-out shift register. The master
+* 				reset is checked, SHIFT_PATTERN is then clocked in with
+* 				every parallel output compared port-wide after every clock
+* 				edge, and finally the reset is checked again with every
+* 				stage loaded. Every edge is followed by the checker settle
+* 				time of the IC (see CheckerGetSettle).
+*
+* Arguments:    const IC_PARAMETERS_T *IC - Structure holding IC parameters
+*
+* 				uint8_t *fail_step - Failing step (0 first reset, n clock
+* 				edge n, SHIFT_NUM_CLOCKS + 1 final reset)
+*
+* Return:		Test pass or test failure
+******************************************************************************/
+uint8_t ShiftRegTest(const IC_PARAMETERS_T*, uint8_t*);
+
+#endif /* SHIFTREG_H_ */
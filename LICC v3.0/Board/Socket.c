@@ -0,0 +1,284 @@
+/******************************************************************************
+* 	Socket.c
+*
+* 	This source file holds the mapping between the 14 pin DIP test socket and
+* 	the MCU GPIO, as well as port-wide helpers for changing socket pin modes.
+* 	Socket pins are handled as a packed word, GPIOA in bits [15:0] and GPIOB
+* 	in bits [31:16], so any set of pins can be driven or read with one access
+* 	per port.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/05/2019:
+* 	Created socket pin map and port-wide drive/read helpers.
+*
+* 	08/06/2019:
+* 	Added single pin port lookup.
+*
+* 	08/20/2019:
+* 	Added port-wide output speed helper.
+*
+* 	08/31/2019:
+* 	Mode changes made atomic against the over-current interrupt.
+*
+* 	Created on: 08/05/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Socket.h"
+
+/******************************************************************************
+* Public Constants
+******************************************************************************/
+const uint32_t SocketPinMask[SOCKET_NUM_PINS + 1] = {
+	0U,					// (unused)
+	(1U << (16 + 11)),	// Pin 1  - PB11
+	(1U << (16 + 10)),	// Pin 2  - PB10
+	(1U << (16 + 2)),	// Pin 3  - PB2
+	(1U << (16 + 1)),	// Pin 4  - PB1
+	(1U << (16 + 0)),	// Pin 5  - PB0
+	(1U << 7),			// Pin 6  - PA7
+	0U,					// Pin 7  - GND
+	(1U << 6),			// Pin 8  - PA6
+	(1U << 5),			// Pin 9  - PA5
+	(1U << 4),			// Pin 10 - PA4
+	(1U << 3),			// Pin 11 - PA3
+	(1U << 2),			// Pin 12 - PA2
+	(1U << 1),			// Pin 13 - PA1
+	0U					// Pin 14 - VCC
+};
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint32_t socketFieldMask(uint16_t);
+
+/******************************************************************************
+* SocketInit - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables clocks for GPIO ports A and B and floats every
+* 				socket pin (input mode, no pull).
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void SocketInit(void)
+{
+	RCC->AHBENR |= (RCC_AHBENR_GPIOAEN | RCC_AHBENR_GPIOBEN);
+
+	SocketFloat();
+}
+
+/******************************************************************************
+* SocketSetOutputs - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Over-current interrupt masked around the mode register
+* 				update.
+*
+* Description:  Sets every socket pin in the packed mask to general purpose
+* 				output mode (MCU drives the pin). Each mode register is
+* 				read, modified and written with the ADC interrupt masked,
+* 				so an over-current shutdown (see OverCurrent.c) that
+* 				floats the socket in between is not undone by the write
+* 				back. The shutdown is delayed by at most the few cycles
+* 				of the update, and the interrupt is only unmasked again
+* 				if it was enabled.
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* Return:		None
+******************************************************************************/
+void SocketSetOutputs(uint32_t mask)
+{
+	uint32_t field_a = socketFieldMask(mask & SOCKET_PORTA_MASK);
+	uint32_t field_b = socketFieldMask((mask & SOCKET_PORTB_MASK) >> 16);
+	uint32_t oc_enable;
+
+	// MODER 01 = general purpose output
+	SOCKET_MODE_LOCK(oc_enable);
+	GPIOA->MODER = ((GPIOA->MODER & ~field_a) | (field_a & 0x55555555U));
+	GPIOB->MODER = ((GPIOB->MODER & ~field_b) | (field_b & 0x55555555U));
+	SOCKET_MODE_UNLOCK(oc_enable);
+}
+
+/******************************************************************************
+* SocketSetInputs - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/31/2019:	Anthony Needles
+* 				Over-current interrupt masked around the mode register
+* 				update.
+*
+* Description:  Sets every socket pin in the packed mask to input mode (pin
+* 				is driven by the tested IC). The ADC interrupt is masked
+* 				around the mode register updates, as in SocketSetOutputs.
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* Return:		None
+******************************************************************************/
+void SocketSetInputs(uint32_t mask)
+{
+	uint32_t field_a = socketFieldMask(mask & SOCKET_PORTA_MASK);
+	uint32_t field_b = socketFieldMask((mask & SOCKET_PORTB_MASK) >> 16);
+	uint32_t oc_enable;
+
+	// MODER 00 = input
+	SOCKET_MODE_LOCK(oc_enable);
+	GPIOA->MODER &= ~field_a;
+	GPIOB->MODER &= ~field_b;
+	SOCKET_MODE_UNLOCK(oc_enable);
+}
+
+/******************************************************************************
+* SocketSetPull - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Applies the given pull-up/pull-down setting to every socket
+* 				pin in the packed mask.
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* 				SOCKET_PULL_T pull - Pull setting to apply
+*
+* Return:		None
+******************************************************************************/
+void SocketSetPull(uint32_t mask, SOCKET_PULL_T pull)
+{
+	uint32_t field_a = socketFieldMask(mask & SOCKET_PORTA_MASK);
+	uint32_t field_b = socketFieldMask((mask & SOCKET_PORTB_MASK) >> 16);
+	uint32_t pattern;
+
+	// PUPDR 00 = none, 01 = pull-up, 10 = pull-down
+	switch(pull){
+	case SOCKET_PULL_UP:
+		pattern = 0x55555555U;
+		break;
+
+	case SOCKET_PULL_DOWN:
+		pattern = 0xAAAAAAAAU;
+		break;
+
+	default:
+		pattern = 0x00000000U;
+		break;
+	}
+
+	GPIOA->PUPDR = ((GPIOA->PUPDR & ~field_a) | (field_a & pattern));
+	GPIOB->PUPDR = ((GPIOB->PUPDR & ~field_b) | (field_b & pattern));
+}
+
+/******************************************************************************
+* SocketSetSpeed - Public Function
+*
+* 08/20/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Applies the given output speed (edge rate) to every socket
+* 				pin in the packed mask. Only affects pins in output mode.
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* 				SOCKET_SPEED_T speed - Speed setting to apply
+*
+* Return:		None
+******************************************************************************/
+void SocketSetSpeed(uint32_t mask, SOCKET_SPEED_T speed)
+{
+	uint32_t field_a = socketFieldMask(mask & SOCKET_PORTA_MASK);
+	uint32_t field_b = socketFieldMask((mask & SOCKET_PORTB_MASK) >> 16);
+	uint32_t pattern = (uint32_t)speed * 0x55555555U;
+
+	GPIOA->OSPEEDR = ((GPIOA->OSPEEDR & ~field_a) | (field_a & pattern));
+	GPIOB->OSPEEDR = ((GPIOB->OSPEEDR & ~field_b) | (field_b & pattern));
+}
+
+/******************************************************************************
+* SocketFloat - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/20/2019:	Anthony Needles
+* 				Output speed returned to reset value.
+*
+* Description:  Returns every socket pin to input mode with no pull, so
+* 				nothing is driven into the socket. Output speed is
+* 				returned to low, so the next mode starts from reset
+* 				edge rates.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void SocketFloat(void)
+{
+	SocketSetInputs(SOCKET_ALL_MASK);
+	SocketSetPull(SOCKET_ALL_MASK, SOCKET_PULL_NONE);
+	SocketSetSpeed(SOCKET_ALL_MASK, SOCKET_SPEED_LOW);
+}
+
+/******************************************************************************
+* SocketPinPort - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the GPIO port and port bit number an IC pin is routed
+* 				to, for code that must touch a single pin's registers
+* 				directly (alternate function, timing critical mode changes).
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* 				uint8_t *port_bit - Returns bit number within the port
+*
+* Return:		GPIO port of pin, 0 if pin is not routed to the MCU
+******************************************************************************/
+GPIO_TypeDef *SocketPinPort(uint8_t ic_pin, uint8_t *port_bit)
+{
+	uint32_t pin_mask;
+	uint8_t bit = 0;
+
+	if((ic_pin > SOCKET_NUM_PINS) || (SocketPinMask[ic_pin] == 0U)) return 0;
+	pin_mask = SocketPinMask[ic_pin];
+
+	while((pin_mask & (1U << bit)) == 0) bit++;
+	*port_bit = (bit & 0xF);
+
+	return (bit < 16) ? GPIOA : GPIOB;
+}
+
+/******************************************************************************
+* socketFieldMask - Private Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Expands a 16-bit port pin mask into the matching 2-bit field
+* 				mask used by MODER, OSPEEDR and PUPDR (pin n -> bits 2n+1:2n).
+*
+* Arguments:    uint16_t port_mask - Pin mask of a single GPIO port
+*
+* Return:		2-bit per pin field mask
+******************************************************************************/
+static uint32_t socketFieldMask(uint16_t port_mask)
+{
+	uint32_t field_mask = 0U;
+
+	for(uint8_t pin = 0; pin < 16; pin++){
+		if(port_mask & (1U << pin)) field_mask |= (0x3U << (pin * 2));
+	}
+	return field_mask;
+}
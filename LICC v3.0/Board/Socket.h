@@ -0,0 +1,194 @@
+/******************************************************************************
+* 	Socket.h
+*
+* 	Header for Socket.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/05/2019:
+* 	Created socket pin map and port-wide drive/read helpers.
+*
+* 	08/06/2019:
+* 	Added single pin port lookup.
+*
+* 	08/20/2019:
+* 	Added port-wide output speed helper.
+*
+* 	08/31/2019:
+* 	Added over-current safe mode register update guard.
+*
+* 	Created on: 08/05/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef SOCKET_H_
+#define SOCKET_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define SOCKET_NUM_PINS 14U
+// 14 pin DIP socket. Pin 7 is GND and pin 14 is VCC, neither is routed to
+// the MCU.
+
+#define SOCKET_PORTA_MASK 0x000000FEU
+#define SOCKET_PORTB_MASK 0x0C070000U
+#define SOCKET_ALL_MASK (SOCKET_PORTA_MASK | SOCKET_PORTB_MASK)
+// Packed socket word: bits [15:0] are GPIOA bits, bits [31:16] are GPIOB bits.
+// Socket pins sit on PA1-PA7 and PB0-PB2, PB10, PB11.
+
+#define SOCKET_READ() (((GPIOA->IDR & 0xFFFFU) | (GPIOB->IDR << 16)) & SOCKET_ALL_MASK)
+// Reads every socket pin at once, returned as a packed socket word
+
+#define SOCKET_BSRR_A(word, mask) ((((word) & (mask)) & 0xFFFFU) | (((~(word) & (mask)) & 0xFFFFU) << 16))
+#define SOCKET_BSRR_B(word, mask) ((((word) & (mask)) >> 16) | ((~(word) & (mask)) & 0xFFFF0000U))
+// Converts a packed word and packed pin mask into BSRR values for each port.
+// Only pins in mask are set (word bit = 1) or reset (word bit = 0).
+
+#define SOCKET_WRITE(word, mask) do { GPIOA->BSRR = SOCKET_BSRR_A((word), (mask)); \
+									  GPIOB->BSRR = SOCKET_BSRR_B((word), (mask)); } while(0)
+// Drives all socket pins in mask at once (pins must already be outputs)
+
+#define SOCKET_MODE_LOCK(saved) do { (saved) = NVIC->ISER[0U] & (1UL << ADC1_IRQn); \
+									 NVIC->ICER[0U] = (saved); } while(0)
+#define SOCKET_MODE_UNLOCK(saved) (NVIC->ISER[0U] = (saved))
+// Masks the over-current (ADC) interrupt around a read-modify-write of a
+// socket port mode register, so a shutdown that floats the socket in between
+// is not undone by the write back. Unmasked again only if it was enabled.
+
+typedef enum {SOCKET_PULL_NONE,
+			  SOCKET_PULL_UP,
+			  SOCKET_PULL_DOWN
+} SOCKET_PULL_T;
+// PUPDR setting for socket pins
+
+typedef enum {SOCKET_SPEED_LOW = 0,
+			  SOCKET_SPEED_MEDIUM = 1,
+			  SOCKET_SPEED_HIGH = 3
+} SOCKET_SPEED_T;
+// OSPEEDR setting for socket pins (low is the reset value, slowest edges)
+
+/******************************************************************************
+* Public Constants
+******************************************************************************/
+extern const uint32_t SocketPinMask[SOCKET_NUM_PINS + 1];
+// Packed socket word bit for each DIP pin, indexed by pin number (1-14).
+// Unrouted pins (7, 14) and index 0 are 0.
+
+/******************************************************************************
+* SocketInit - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables clocks for GPIO ports A and B and floats every
+* 				socket pin (input mode, no pull).
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void SocketInit(void);
+
+/******************************************************************************
+* SocketSetOutputs - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets every socket pin in the packed mask to general purpose
+* 				output mode (MCU drives the pin).
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* Return:		None
+******************************************************************************/
+void SocketSetOutputs(uint32_t);
+
+/******************************************************************************
+* SocketSetInputs - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets every socket pin in the packed mask to input mode (pin
+* 				is driven by the tested IC).
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* Return:		None
+******************************************************************************/
+void SocketSetInputs(uint32_t);
+
+/******************************************************************************
+* SocketSetPull - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Applies the given pull-up/pull-down setting to every socket
+* 				pin in the packed mask.
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* 				SOCKET_PULL_T pull - Pull setting to apply
+*
+* Return:		None
+******************************************************************************/
+void SocketSetPull(uint32_t, SOCKET_PULL_T);
+
+/******************************************************************************
+* SocketSetSpeed - Public Function
+*
+* 08/20/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Applies the given output speed (edge rate) to every socket
+* 				pin in the packed mask. Only affects pins in output mode.
+*
+* Arguments:    uint32_t mask - Packed socket pin mask
+*
+* 				SOCKET_SPEED_T speed - Speed setting to apply
+*
+* Return:		None
+******************************************************************************/
+void SocketSetSpeed(uint32_t, SOCKET_SPEED_T);
+
+/******************************************************************************
+* SocketFloat - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/20/2019:	Anthony Needles
+* 				Output speed returned to reset value.
+*
+* Description:  Returns every socket pin to input mode with no pull, so
+* 				nothing is driven into the socket. Output speed is
+* 				returned to low, so the next mode starts from reset
+* 				edge rates.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void SocketFloat(void);
+
+/******************************************************************************
+* SocketPinPort - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the GPIO port and port bit number an IC pin is routed
+* 				to, for code that must touch a single pin's registers
+* 				directly (alternate function, timing critical mode changes).
+*
+* Arguments:    uint8_t ic_pin - IC pin number
+*
+* 				uint8_t *port_bit - Returns bit number within the port
+*
+* Return:		GPIO port of pin, 0 if pin is not routed to the MCU
+******************************************************************************/
+GPIO_TypeDef *SocketPinPort(uint8_t, uint8_t*);
+
+#endif /* SOCKET_H_ */
@@ -0,0 +1,247 @@
+/******************************************************************************
+* 	UserIc.c
+*
+* 	This source file stores IC definitions uploaded at runtime in a reserved
+* 	flash page, so new gate ICs can be tested without rebuilding firmware.
+* 	An uploaded IC is a set of identical gates given by a truth table. It
+* 	is kept as ordinary IC parameters, which the checker compiles into the
+* 	same vector program as a built-in IC. Records are appended into erased
+* 	flash, each one's magic halfword is programmed last so a record cut
+* 	short by a reset is never taken as valid.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/17/2019:
+* 	Created flash store of IC definitions uploaded at runtime.
+*
+* 	08/26/2019:
+* 	Uploaded ICs carry their output type.
+*
+* 	Created on: 08/17/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Flash.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "UserIc.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define USERIC_MAGIC 0x5543U
+// "UC", marks a complete record
+
+#define USERIC_EMPTY 0xFFFFU
+// Erased flash halfword
+
+typedef struct {
+	uint16_t magic;
+	uint16_t reserved;
+	char name[USERIC_NAME_LEN];
+	IC_PARAMETERS_T params;
+} USERIC_RECORD_T;
+// User IC as stored in flash
+
+#define USERIC_RECORD_HALFWORDS (sizeof(USERIC_RECORD_T) / 2U)
+
+#define USERIC ((const USERIC_RECORD_T *)FLASH_USERIC_PAGE)
+// Records as stored in FLASH_USERIC_PAGE
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint8_t userIcValidate(const USERIC_DESCRIPTOR_T*);
+static uint8_t userIcSlotErased(uint8_t);
+
+/******************************************************************************
+* UserIcStore - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Validates an uploaded IC and stores it in the next free
+* 				slot of the user IC flash page. The truth table is widened
+* 				to the 4 input form the checker uses, unused inputs set.
+* 				The IC can be tested as soon as this returns.
+*
+* Arguments:    const USERIC_DESCRIPTOR_T *desc - Uploaded IC
+*
+* 				IC_DESIGNATOR_T *ic_designator - Returns designator given
+*
+* Return:		USERIC_OK or reason the IC was not stored
+******************************************************************************/
+uint8_t UserIcStore(const USERIC_DESCRIPTOR_T *desc, IC_DESIGNATOR_T *ic_designator)
+{
+	USERIC_RECORD_T record;
+	const uint16_t *halfwords = (const uint16_t *)&record;
+	uint8_t unused = 0x0FU >> desc->gate_inputs;
+	uint8_t status = userIcValidate(desc);
+	uint8_t slot;
+
+	if(status != USERIC_OK) return status;
+
+	for(slot = 0; slot < USERIC_NUM_SLOTS; slot++){
+		if(userIcSlotErased(slot) == 1U) break;
+	}
+	if(slot == USERIC_NUM_SLOTS) return USERIC_FULL;
+
+	record.magic = USERIC_MAGIC;
+	record.reserved = 0U;
+	for(uint8_t index = 0; index < USERIC_NAME_LEN; index++) record.name[index] = desc->name[index];
+
+	record.params.ic_designator = (IC_DESIGNATOR_T)(IC_USER + slot);
+	record.params.num_inputs = desc->num_gates * desc->gate_inputs;
+	record.params.num_outputs = desc->num_gates;
+	for(uint8_t index = 0; index < 9U; index++){
+		record.params.input_pins[index] = (index < record.params.num_inputs) ? desc->input_pins[index] : 0U;
+	}
+	for(uint8_t index = 0; index < 8U; index++){
+		record.params.output_pins[index] = (index < desc->num_gates) ? desc->output_pins[index] : 0U;
+	}
+	record.params.ic_class = IC_CLASS_GATE;
+	record.params.output_type = desc->output_type;
+	record.params.truth_table = 0U;
+	for(uint8_t combination = 0; combination < 16U; combination++){
+		if((combination >> desc->gate_inputs) != unused) continue;
+		if(desc->truth_table & (1U << (combination & ((1U << desc->gate_inputs) - 1U)))){
+			record.params.truth_table |= (1U << combination);
+		}
+	}
+
+	// Magic last, the record only becomes valid once complete
+	if(FlashProgram((uint32_t)&USERIC[slot] + 2U, &halfwords[1], USERIC_RECORD_HALFWORDS - 1U) != FLASH_OK) return USERIC_FLASH_ERROR;
+	if(FlashProgram((uint32_t)&USERIC[slot], &halfwords[0], 1U) != FLASH_OK) return USERIC_FLASH_ERROR;
+
+	*ic_designator = record.params.ic_designator;
+	return USERIC_OK;
+}
+
+/******************************************************************************
+* UserIcGet - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the parameters of a stored user IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - User IC designator
+*
+* Return:		Parameters in flash, 0 if no such IC is stored
+******************************************************************************/
+const IC_PARAMETERS_T *UserIcGet(IC_DESIGNATOR_T ic_designator)
+{
+	uint8_t slot = ic_designator - IC_USER;
+
+	if((ic_designator < IC_USER) || (slot >= USERIC_NUM_SLOTS)) return 0;
+	if(USERIC[slot].magic != USERIC_MAGIC) return 0;
+	return &USERIC[slot].params;
+}
+
+/******************************************************************************
+* UserIcName - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the name of a stored user IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - User IC designator
+*
+* Return:		USERIC_NAME_LEN name bytes in flash, 0 if no such IC
+******************************************************************************/
+const char *UserIcName(IC_DESIGNATOR_T ic_designator)
+{
+	if(UserIcGet(ic_designator) == 0) return 0;
+	return USERIC[ic_designator - IC_USER].name;
+}
+
+/******************************************************************************
+* UserIcClear - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Erases every stored user IC. A compiled program of a user
+* 				IC is discarded, its designator may be reused.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void UserIcClear(void)
+{
+	FlashErasePage(FLASH_USERIC_PAGE);
+	CheckerInvalidateProgram();
+}
+
+/******************************************************************************
+* userIcValidate - Private Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/26/2019:	Anthony Needles
+* 				Output type checked.
+*
+* Description:  Checks that an uploaded IC fits the checker: 1 to 8 gates
+* 				of 1 to 4 inputs with no more than 9 inputs in all, every
+* 				pin a routed socket pin used only once, and a truth table
+* 				that uses only its 2^gate_inputs bits and is not constant
+* 				(a constant output cannot be told from a stuck one), and
+* 				a known output type.
+*
+* Arguments:    const USERIC_DESCRIPTOR_T *desc - Uploaded IC
+*
+* Return:		USERIC_OK or reason the IC is rejected
+******************************************************************************/
+static uint8_t userIcValidate(const USERIC_DESCRIPTOR_T *desc)
+{
+	uint16_t num_inputs = desc->num_gates * desc->gate_inputs;
+	uint16_t full_table;
+	uint32_t used = 0U;
+	uint32_t pin_mask;
+	uint8_t ic_pin;
+
+	if((desc->num_gates == 0U) || (desc->num_gates > 8U)) return USERIC_BAD_SHAPE;
+	if((desc->gate_inputs == 0U) || (desc->gate_inputs > 4U) || (num_inputs > 9U)) return USERIC_BAD_SHAPE;
+
+	for(uint8_t index = 0; index < (num_inputs + desc->num_gates); index++){
+		ic_pin = (index < num_inputs) ? desc->input_pins[index] : desc->output_pins[index - num_inputs];
+		if((ic_pin == 0U) || (ic_pin > SOCKET_NUM_PINS)) return USERIC_BAD_PINS;
+		pin_mask = SocketPinMask[ic_pin];
+		if((pin_mask == 0U) || (used & pin_mask)) return USERIC_BAD_PINS;
+		used |= pin_mask;
+	}
+
+	full_table = (uint16_t)((1UL << (1U << desc->gate_inputs)) - 1U);
+	if(desc->truth_table & ~full_table) return USERIC_BAD_TABLE;
+	if((desc->truth_table == 0U) || (desc->truth_table == full_table)) return USERIC_BAD_TABLE;
+	if(desc->output_type > IC_OUTPUT_OPEN_DRAIN) return USERIC_BAD_SHAPE;
+
+	return USERIC_OK;
+}
+
+/******************************************************************************
+* userIcSlotErased - Private Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Checks that every halfword of a slot is erased. A slot left
+* 				part written by a reset is not reused until the page is
+* 				cleared.
+*
+* Arguments:    uint8_t slot - Slot number
+*
+* Return:		1 if erased, otherwise 0
+******************************************************************************/
+static uint8_t userIcSlotErased(uint8_t slot)
+{
+	const uint16_t *halfwords = (const uint16_t *)&USERIC[slot];
+
+	for(uint16_t index = 0; index < USERIC_RECORD_HALFWORDS; index++){
+		if(halfwords[index] != USERIC_EMPTY) return 0U;
+	}
+	return 1U;
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+* 	UserIc.h
+*
+* 	Header for UserIc.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/17/2019:
+* 	Created flash store of IC definitions uploaded at runtime.
+*
+* 	08/26/2019:
+* 	Uploaded ICs carry their output type.
+*
+* 	Created on: 08/17/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef USERIC_H_
+#define USERIC_H_
+
+#include "Checker.h"
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define USERIC_NUM_SLOTS 6U
+// Uploaded ICs are IC_USER to IC_USER + 5, keeping every designator within
+// the 4 bits a fault log record holds
+
+#define USERIC_NAME_LEN 8U
+// Part name, zero padded (not terminated when all 8 are used)
+
+#define USERIC_OK 0U
+#define USERIC_BAD_SHAPE 1U
+#define USERIC_BAD_PINS 2U
+#define USERIC_BAD_TABLE 3U
+#define USERIC_FULL 4U
+#define USERIC_FLASH_ERROR 5U
+// UserIcStore results
+
+typedef struct {
+	char name[USERIC_NAME_LEN];
+	uint8_t num_gates;
+	uint8_t gate_inputs;
+	uint8_t input_pins[9];
+	uint8_t output_pins[8];
+	uint16_t truth_table;
+	uint8_t output_type;
+} USERIC_DESCRIPTOR_T;
+// Uploaded IC: name, number of identical gates and inputs per gate, input
+// pins grouped by gate, output pin of each gate, the gate truth table
+// (bit n = output for inputs n, bit 0 = first input, 2^gate_inputs bits),
+// and output type (IC_OUTPUT_T)
+
+/******************************************************************************
+* UserIcStore - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Validates an uploaded IC and stores it in the next free
+* 				slot of the user IC flash page. It can be tested at once.
+*
+* Arguments:    const USERIC_DESCRIPTOR_T *desc - Uploaded IC
+*
+* 				IC_DESIGNATOR_T *ic_designator - Returns designator given
+*
+* Return:		USERIC_OK or reason the IC was not stored
+******************************************************************************/
+uint8_t UserIcStore(const USERIC_DESCRIPTOR_T*, IC_DESIGNATOR_T*);
+
+/******************************************************************************
+* UserIcGet - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the parameters of a stored user IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - User IC designator
+*
+* Return:		Parameters in flash, 0 if no such IC is stored
+******************************************************************************/
+const IC_PARAMETERS_T *UserIcGet(IC_DESIGNATOR_T);
+
+/******************************************************************************
+* UserIcName - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Finds the name of a stored user IC.
+*
+* Arguments:    IC_DESIGNATOR_T ic_designator - User IC designator
+*
+* Return:		USERIC_NAME_LEN name bytes in flash, 0 if no such IC
+******************************************************************************/
+const char *UserIcName(IC_DESIGNATOR_T);
+
+/******************************************************************************
+* UserIcClear - Public Function
+*
+* 08/17/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Erases every stored user IC.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void UserIcClear(void);
+
+#endif /* USERIC_H_ */
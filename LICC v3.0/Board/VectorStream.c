@@ -0,0 +1,197 @@
+/******************************************************************************
+* 	VectorStream.c
+*
+* 	This source file applies test vectors streamed from the host, for
+* 	programs too large to hold on the device. USART1 circular DMA receives
+* 	vectors into a two chunk ring in the workspace while the CPU applies
+* 	the other chunk, with a ready byte sent back for every chunk freed. A
+* 	vector costs ~6 bytes on the link against ~6us to apply, so the vector
+* 	rate is set by the baud rate. Only mismatches are sent back.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/18/2019:
+* 	Created host streamed vector mode.
+*
+* 	Created on: 08/18/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "SysTick.h"
+#include "Timestamp.h"
+#include "Usart1.h"
+#include "Socket.h"
+#include "Checker.h"
+#include "Workspace.h"
+#include "LogicAnalyzer.h"
+#include "VectorStream.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define TRUE 1U
+
+#define VS_VECTOR_HALFWORDS 3U
+
+#define VS_RING_VECTORS (2U * VS_CHUNK)
+#define VS_RING_BYTES (VS_RING_VECTORS * VS_VECTOR_HALFWORDS * 2U)
+// Two chunks, one applied while the other is received (fills the workspace)
+
+#define VS_IDLE_TIMEOUT_MS 200U
+// Longest wait for the next vector before the stream is abandoned
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static VS_SUMMARY_T vsSummary;
+static uint8_t vsReport[7];
+static const uint8_t vsReady = VS_READY;
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static uint32_t vsPinsToMask(uint16_t);
+static void vsReportMismatch(uint32_t, uint32_t);
+
+/******************************************************************************
+* VsRun - Public Function
+*
+* 08/18/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Applies vectors streamed from the host over USART1 back to
+* 				back until the end vector, reporting only mismatches. The
+* 				device sends VS_READY whenever the host may send the next
+* 				VS_CHUNK vectors, two are sent at the start. The socket is
+* 				floated and the summary sent when the stream ends.
+*
+* Arguments:    const VS_CONFIG_T *config - Stream settings
+*
+* Return:		Summary of the stream (also sent to the host)
+******************************************************************************/
+const VS_SUMMARY_T *VsRun(const VS_CONFIG_T *config)
+{
+	uint16_t *ring = (uint16_t *)Workspace;
+	uint32_t drive_mask = vsPinsToMask(config->drive_pins);
+	uint16_t settle = (config->settle_cycles != 0U) ? config->settle_cycles : CYCLES_DELAY;
+	uint32_t start_ms = SysTickGetMS();
+	uint32_t idle_ms = start_ms;
+	uint32_t received = 0U;
+	uint32_t applied = 0U;
+	uint16_t rx_last = 0U;
+	uint16_t rx_pos;
+	const uint16_t *vector;
+	uint32_t expect;
+	uint32_t care;
+	uint32_t read;
+	uint16_t start;
+
+	vsSummary.tag = VS_END;
+	vsSummary.flags = 0U;
+	vsSummary.reserved = 0U;
+	vsSummary.num_mismatches = 0U;
+
+	SocketFloat();
+	SocketSetOutputs(drive_mask);
+
+	Usart1RxStart(ring, VS_RING_BYTES, TRUE);
+	Usart1Write(&vsReady, 1U);
+	Usart1Write(&vsReady, 1U);
+
+	while(1){
+		rx_pos = Usart1RxPos();
+		received += (uint16_t)(rx_pos - rx_last + VS_RING_BYTES) % VS_RING_BYTES;
+		rx_last = rx_pos;
+
+		if((received / (VS_VECTOR_HALFWORDS * 2U)) <= applied){
+			if((SysTickGetMS() - idle_ms) >= VS_IDLE_TIMEOUT_MS){
+				vsSummary.flags |= VS_FLAG_TIMEOUT;
+				break;
+			}
+			continue;
+		}
+		idle_ms = SysTickGetMS();
+
+		vector = &ring[(applied % VS_RING_VECTORS) * VS_VECTOR_HALFWORDS];
+		if(vector[0] & VS_END_FLAG) break;
+
+		expect = LA_UNPACK(vector[1]);
+		care = LA_UNPACK(vector[2]);
+		SOCKET_WRITE(LA_UNPACK(vector[0]), drive_mask);
+		start = TIMESTAMP_NOW();
+		while((uint16_t)(TIMESTAMP_NOW() - start) < settle){}
+		read = SOCKET_READ();
+
+		if((read ^ expect) & care) vsReportMismatch(applied, read);
+
+		applied++;
+		if((applied % VS_CHUNK) == 0U) Usart1Write(&vsReady, 1U);
+	}
+
+	Usart1RxStop();
+	SocketFloat();
+
+	vsSummary.num_vectors = applied;
+	vsSummary.duration_ms = SysTickGetMS() - start_ms;
+	Usart1Write(&vsSummary, sizeof(vsSummary));
+	Usart1Flush();
+	return &vsSummary;
+}
+
+/******************************************************************************
+* vsPinsToMask - Private Function
+*
+* 08/18/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a bit field of IC pins into a packed socket mask.
+*
+* Arguments:    uint16_t ic_pins - Bit field of IC pins (bit n = IC pin n)
+*
+* Return:		Packed socket pin mask
+******************************************************************************/
+static uint32_t vsPinsToMask(uint16_t ic_pins)
+{
+	uint32_t mask = 0U;
+
+	for(uint8_t ic_pin = 1; ic_pin <= SOCKET_NUM_PINS; ic_pin++){
+		if(ic_pins & (1U << ic_pin)) mask |= SocketPinMask[ic_pin];
+	}
+	return mask;
+}
+
+/******************************************************************************
+* vsReportMismatch - Private Function
+*
+* 08/18/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Counts a mismatching vector and reports it to the host,
+* 				up to VS_MAX_REPORTS per stream.
+*
+* Arguments:    uint32_t vector_num - Vector number in the stream
+*
+* 				uint32_t read - Packed socket word read
+*
+* Return:		None
+******************************************************************************/
+static void vsReportMismatch(uint32_t vector_num, uint32_t read)
+{
+	uint16_t word = LA_PACK(read & 0xFFFFU, read >> 16);
+
+	if(vsSummary.num_mismatches++ >= VS_MAX_REPORTS){
+		vsSummary.flags |= VS_FLAG_REPORTS_DROPPED;
+		return;
+	}
+
+	// Report buffer is read by DMA until the last report has gone
+	while(Usart1TxDone() == 0U){}
+	vsReport[0] = VS_MISMATCH;
+	vsReport[1] = vector_num & 0xFFU;
+	vsReport[2] = (vector_num >> 8) & 0xFFU;
+	vsReport[3] = (vector_num >> 16) & 0xFFU;
+	vsReport[4] = vector_num >> 24;
+	vsReport[5] = word & 0xFFU;
+	vsReport[6] = word >> 8;
+	Usart1Write(vsReport, sizeof(vsReport));
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+* 	VectorStream.h
+*
+* 	Header for VectorStream.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/18/2019:
+* 	Created host streamed vector mode.
+*
+* 	Created on: 08/18/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef VECTORSTREAM_H_
+#define VECTORSTREAM_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define VS_CHUNK 256U
+// Vectors the host may send for each VS_READY
+
+#define VS_END_FLAG 0x0001U
+// Vectors are three halfwords in analyzer word form (see LogicAnalyzer.h):
+// drive levels, expected levels, output pins checked. Analyzer word bit 0
+// is never a socket pin, a drive word with it set ends the stream.
+
+#define VS_READY 0x52U
+// "R", host may send VS_CHUNK more vectors
+
+#define VS_MISMATCH 0x4DU
+// "M", followed by u32 vector number and u16 analyzer word read
+
+#define VS_END 0x45U
+// "E", start of the VS_SUMMARY_T sent when the stream ends
+
+#define VS_MAX_REPORTS 64U
+// Mismatches reported individually, the rest are only counted
+
+#define VS_FLAG_TIMEOUT 0x01U
+#define VS_FLAG_REPORTS_DROPPED 0x02U
+// Summary flags: host stopped sending before the end vector, more than
+// VS_MAX_REPORTS mismatches
+
+typedef struct {
+	uint16_t drive_pins;
+	uint16_t settle_cycles;
+} VS_CONFIG_T;
+// IC pins driven by the vectors (bit n = IC pin n, the rest are inputs) and
+// SYSCLK cycles between driving and reading (0 for CYCLES_DELAY)
+
+typedef struct {
+	uint8_t tag;
+	uint8_t flags;
+	uint16_t reserved;
+	uint32_t num_vectors;
+	uint32_t num_mismatches;
+	uint32_t duration_ms;
+} VS_SUMMARY_T;
+// Sent after the last vector: VS_END, flags, vectors applied, vectors that
+// mismatched, and time from first vector to end
+
+/******************************************************************************
+* VsRun - Public Function
+*
+* 08/18/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Applies vectors streamed from the host over USART1 back to
+* 				back until the end vector, reporting only mismatches. The
+* 				device sends VS_READY whenever the host may send the next
+* 				VS_CHUNK vectors, two are sent at the start.
+*
+* Arguments:    const VS_CONFIG_T *config - Stream settings
+*
+* Return:		Summary of the stream (also sent to the host)
+******************************************************************************/
+const VS_SUMMARY_T *VsRun(const VS_CONFIG_T*);
+
+#endif /* VECTORSTREAM_H_ */
@@ -0,0 +1,22 @@
+/******************************************************************************
+* 	Workspace.c
+*
+* 	This source file holds the RAM workspace shared by the instrument modes,
+* 	which are never run at the same time. Sharing one block lets each mode
+* 	use most of the free RAM.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/14/2019:
+* 	Created shared RAM workspace for the instrument modes.
+*
+* 	Created on: 08/14/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Workspace.h"
+
+/******************************************************************************
+* Public Variables
+******************************************************************************/
+uint32_t Workspace[WORKSPACE_WORDS];
@@ -0,0 +1,36 @@
+/******************************************************************************
+* 	Workspace.h
+*
+* 	Header for Workspace.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/14/2019:
+* 	Created shared RAM workspace for the instrument modes.
+*
+* 	08/25/2019:
+* 	Checker uses it as scratch while compiling bridging vectors.
+*
+* 	Created on: 08/14/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef WORKSPACE_H_
+#define WORKSPACE_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define WORKSPACE_BYTES 3072U
+// Largest RAM block left after the test engine, stack and heap
+
+#define WORKSPACE_WORDS (WORKSPACE_BYTES / 4U)
+
+/******************************************************************************
+* Public Variables
+******************************************************************************/
+extern uint32_t Workspace[WORKSPACE_WORDS];
+// Buffer shared by the instrument modes (logic analyzer, pattern generator,
+// host vector streaming) and the checker's program compiler. Only one mode
+// runs at a time and none keep data in it between runs.
+
+#endif /* WORKSPACE_H_ */
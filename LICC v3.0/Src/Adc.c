@@ -0,0 +1,349 @@
+/******************************************************************************
+* 	Adc.c
+*
+* 	This source file converts ADC channels as scan sequences, every channel
+* 	of a sequence converted back to back in hardware with the results moved
+* 	to RAM by DMA1 channel 1. Conversions may also be streamed, started one
+* 	at a time by software at exact points of a test, or monitored
+* 	continuously under the analog watchdog. While otherwise unused the ADC
+* 	can convert in the background into a circular buffer. Dependent on 48MHz
+* 	PCLK derived from 48MHz system clock via HSE and PLL.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/21/2019:
+* 	Created ADC scan sequence conversion through DMA.
+*
+* 	08/23/2019:
+* 	Added software triggered conversion streams.
+*
+* 	08/24/2019:
+* 	Added continuous monitoring and analog watchdog.
+*
+* 	08/28/2019:
+* 	Added background conversion into a circular buffer.
+*
+* 	Created on: 08/21/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Adc.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define ADC_SAMPLE_TIME 6U
+// 71.5 ADC clocks (~6us), longer than the 4us VREFINT and temperature
+// sensor need, and plenty for low impedance IC outputs
+
+#define ADC_STREAM_SAMPLE_TIME 2U
+// 13.5 ADC clocks (ADC_STREAM_SAMPLE_CYCLES)
+
+#define ADC_BACKGROUND_SAMPLE_TIME 7U
+// 239.5 ADC clocks (~20us, ADC_BACKGROUND_PERIOD_CYCLES), the temperature
+// sensor settles best with the longest sample time
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint16_t adcStreamCount;
+static uint8_t adcBackground;
+
+/******************************************************************************
+* AdcInit - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables, calibrates and powers up the ADC, clocked by PCLK/4
+* 				(12MHz), with VREFINT and the temperature sensor enabled.
+* 				Results are right aligned 12-bit, moved by DMA in one-shot
+* 				mode.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void AdcInit(void)
+{
+	RCC->APB2ENR |= RCC_APB2ENR_ADCEN;
+	RCC->AHBENR |= RCC_AHBENR_DMAEN;
+
+	ADC1->CFGR2 = ADC_CFGR2_CKMODE_1;
+
+	// Calibrate with the ADC disabled
+	if(ADC1->CR & ADC_CR_ADEN){
+		ADC1->CR |= ADC_CR_ADDIS;
+		while(ADC1->CR & ADC_CR_ADEN){}
+	}
+	ADC1->CR |= ADC_CR_ADCAL;
+	while(ADC1->CR & ADC_CR_ADCAL){}
+
+	ADC1->CFGR1 = ADC_CFGR1_DMAEN;
+	ADC1->SMPR = ADC_SAMPLE_TIME;
+	ADC1_COMMON->CCR |= ADC_CCR_VREFEN | ADC_CCR_TSEN;
+
+	ADC1->ISR = ADC_ISR_ADRDY;
+	ADC1->CR |= ADC_CR_ADEN;
+	while((ADC1->ISR & ADC_ISR_ADRDY) == 0U){}
+}
+
+/******************************************************************************
+* AdcScan - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a set of channels as one scan sequence, results
+* 				written to RAM by DMA1 channel 1, and waits for it to end.
+*
+* Arguments:    uint32_t channels - Channels to convert (bit n = channel n)
+*
+* 				uint16_t *results - One result per channel, lowest channel
+* 				first
+*
+* Return:		Number of results
+******************************************************************************/
+uint8_t AdcScan(uint32_t channels, uint16_t *results)
+{
+	uint8_t count = 0U;
+
+	channels &= (1UL << ADC_MAX_CHANNELS) - 1U;
+	for(uint8_t channel = 0; channel < ADC_MAX_CHANNELS; channel++){
+		if(channels & (1UL << channel)) count++;
+	}
+	if(count == 0U) return 0U;
+
+	AdcMonitorStop();
+	ADC1->CHSELR = channels;
+
+	DMA1_Channel1->CCR = 0U;
+	DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+	DMA1_Channel1->CMAR = (uint32_t)results;
+	DMA1_Channel1->CNDTR = count;
+	DMA1->IFCR = DMA_IFCR_CGIF1;
+	DMA1_Channel1->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_EN;
+
+	ADC1->ISR = ADC_ISR_EOC | ADC_ISR_EOSEQ | ADC_ISR_OVR;
+	ADC1->CR |= ADC_CR_ADSTART;
+	while((DMA1->ISR & DMA_ISR_TCIF1) == 0U){}
+
+	DMA1_Channel1->CCR = 0U;
+	return count;
+}
+
+/******************************************************************************
+* AdcVddaMv - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Computes VDDA from a VREFINT reading and its factory
+* 				calibration.
+*
+* Arguments:    uint16_t vrefint - VREFINT reading
+*
+* Return:		VDDA in millivolts
+******************************************************************************/
+uint16_t AdcVddaMv(uint16_t vrefint)
+{
+	if(vrefint == 0U) return 0U;
+	return (uint16_t)(((uint32_t)ADC_CAL_MV * ADC_VREFINT_CAL) / vrefint);
+}
+
+/******************************************************************************
+* AdcStreamStart - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets up a stream of single conversions of one channel,
+* 				each started by ADC_START() and written to the next result
+* 				by DMA1 channel 1, so the CPU never waits on a conversion.
+* 				Uses a short sample time (ADC_STREAM_SAMPLE_CYCLES), the
+* 				channel must be driven from a low impedance.
+*
+* Arguments:    uint8_t channel - Channel to convert
+*
+* 				uint16_t *results - Buffer for count results
+*
+* 				uint16_t count - Most conversions in the stream
+*
+* Return:		None
+******************************************************************************/
+void AdcStreamStart(uint8_t channel, uint16_t *results, uint16_t count)
+{
+	AdcMonitorStop();
+	adcStreamCount = count;
+	ADC1->CHSELR = (1UL << channel);
+	ADC1->SMPR = ADC_STREAM_SAMPLE_TIME;
+
+	DMA1_Channel1->CCR = 0U;
+	DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+	DMA1_Channel1->CMAR = (uint32_t)results;
+	DMA1_Channel1->CNDTR = count;
+	DMA1->IFCR = DMA_IFCR_CGIF1;
+	DMA1_Channel1->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_EN;
+
+	ADC1->ISR = ADC_ISR_EOC | ADC_ISR_EOSEQ | ADC_ISR_OVR;
+}
+
+/******************************************************************************
+* AdcStreamStop - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits for the last conversion of a stream and restores the
+* 				scan sample time.
+*
+* Arguments:    None
+*
+* Return:		Number of results written
+******************************************************************************/
+uint16_t AdcStreamStop(void)
+{
+	uint16_t written;
+
+	// Result is only read by DMA once the conversion has ended
+	while(ADC1->CR & ADC_CR_ADSTART){}
+	while((ADC1->ISR & ADC_ISR_EOC) && (DMA1_Channel1->CNDTR != 0U)){}
+	written = adcStreamCount - DMA1_Channel1->CNDTR;
+
+	DMA1_Channel1->CCR = 0U;
+	ADC1->SMPR = ADC_SAMPLE_TIME;
+	return written;
+}
+
+/******************************************************************************
+* AdcWatchdogSet - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Guards one channel with the analog watchdog. Any conversion
+* 				of the channel above the threshold, by a scan, stream or
+* 				the monitor, raises the ADC interrupt while it is enabled.
+* 				Stops the monitor, restart it afterwards if needed.
+*
+* Arguments:    uint8_t channel - Channel guarded
+*
+* 				uint16_t high - Highest reading allowed
+*
+* Return:		None
+******************************************************************************/
+void AdcWatchdogSet(uint8_t channel, uint16_t high)
+{
+	AdcMonitorStop();
+
+	ADC1->TR = ((uint32_t)high << ADC_TR1_HT1_Pos);
+	ADC1->CFGR1 = (ADC1->CFGR1 & ~ADC_CFGR1_AWDCH) | ((uint32_t)channel << ADC_CFGR1_AWD1CH_Pos)
+				  | ADC_CFGR1_AWDSGL | ADC_CFGR1_AWDEN;
+	ADC1->ISR = ADC_ISR_AWD;
+}
+
+/******************************************************************************
+* AdcMonitorStart - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts one channel continuously in hardware, without DMA
+* 				and keeping only the latest result, so the analog watchdog
+* 				checks it every ADC_MONITOR_PERIOD_CYCLES. Scans and
+* 				streams stop the monitor.
+*
+* Arguments:    uint8_t channel - Channel monitored
+*
+* Return:		None
+******************************************************************************/
+void AdcMonitorStart(uint8_t channel)
+{
+	AdcMonitorStop();
+	while(ADC1->CR & ADC_CR_ADSTART){}
+
+	ADC1->CFGR1 = (ADC1->CFGR1 & ~ADC_CFGR1_DMAEN) | ADC_CFGR1_CONT | ADC_CFGR1_OVRMOD;
+	ADC1->CHSELR = (1UL << channel);
+	ADC1->SMPR = ADC_STREAM_SAMPLE_TIME;
+	ADC1->ISR = ADC_ISR_EOC | ADC_ISR_EOSEQ | ADC_ISR_OVR;
+	ADC1->CR |= ADC_CR_ADSTART;
+}
+
+/******************************************************************************
+* AdcMonitorStop - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/28/2019:	Anthony Needles
+* 				Also stops background conversion.
+*
+* Description:  Stops continuous monitoring or background conversion, if
+* 				running, and restores scan settings.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void AdcMonitorStop(void)
+{
+	if((ADC1->CFGR1 & ADC_CFGR1_CONT) == 0U) return;
+
+	ADC1->CR |= ADC_CR_ADSTP;
+	while(ADC1->CR & ADC_CR_ADSTP){}
+
+	if(adcBackground != 0U){
+		DMA1_Channel1->CCR = 0U;
+		adcBackground = 0U;
+	}
+
+	ADC1->CFGR1 = (ADC1->CFGR1 & ~(ADC_CFGR1_CONT | ADC_CFGR1_OVRMOD | ADC_CFGR1_DMACFG)) | ADC_CFGR1_DMAEN;
+	ADC1->SMPR = ADC_SAMPLE_TIME;
+}
+
+/******************************************************************************
+* AdcBackgroundStart - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a set of channels continuously as repeated scan
+* 				sequences while the ADC is otherwise unused, with DMA1
+* 				channel 1 writing the results round a circular buffer.
+* 				The DMA half and full transfer interrupts are enabled, the
+* 				user handles DMA1_Channel1_IRQHandler. Uses the longest
+* 				sample time, for the internal channels. Does nothing if
+* 				already running, scans, streams and the monitor stop it.
+*
+* Arguments:    uint32_t channels - Channels to convert (bit n = channel n)
+*
+* 				uint16_t *results - Circular buffer, a whole number of
+* 				sequences in each half
+*
+* 				uint16_t count - Buffer length in results
+*
+* Return:		None
+******************************************************************************/
+void AdcBackgroundStart(uint32_t channels, uint16_t *results, uint16_t count)
+{
+	if(adcBackground != 0U) return;
+
+	AdcMonitorStop();
+	while(ADC1->CR & ADC_CR_ADSTART){}
+
+	ADC1->CFGR1 |= ADC_CFGR1_CONT | ADC_CFGR1_OVRMOD | ADC_CFGR1_DMACFG | ADC_CFGR1_DMAEN;
+	ADC1->CHSELR = channels;
+	ADC1->SMPR = ADC_BACKGROUND_SAMPLE_TIME;
+
+	DMA1_Channel1->CCR = 0U;
+	DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+	DMA1_Channel1->CMAR = (uint32_t)results;
+	DMA1_Channel1->CNDTR = count;
+	DMA1->IFCR = DMA_IFCR_CGIF1;
+	DMA1_Channel1->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_CIRC
+						 | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+
+	adcBackground = 1U;
+	ADC1->ISR = ADC_ISR_EOC | ADC_ISR_EOSEQ | ADC_ISR_OVR;
+	ADC1->CR |= ADC_CR_ADSTART;
+}
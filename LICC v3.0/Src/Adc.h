@@ -0,0 +1,225 @@
+/******************************************************************************
+* 	Adc.h
+*
+* 	Header for Adc.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/21/2019:
+* 	Created ADC scan sequence conversion through DMA.
+*
+* 	08/23/2019:
+* 	Added software triggered conversion streams.
+*
+* 	08/24/2019:
+* 	Added continuous monitoring and analog watchdog.
+*
+* 	08/28/2019:
+* 	Added background conversion into a circular buffer.
+*
+* 	Created on: 08/21/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef ADC_H_
+#define ADC_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define ADC_FULL_SCALE 4095U
+// 12-bit conversion result
+
+#define ADC_CHANNEL_TEMP 16U
+#define ADC_CHANNEL_VREFINT 17U
+// Internal channels (channels 0-9 are PA0-PA7, PB0, PB1)
+
+#define ADC_MAX_CHANNELS 19U
+
+#define ADC_VREFINT_CAL (*(const uint16_t *)0x1FFFF7BAU)
+#define ADC_TS_CAL (*(const uint16_t *)0x1FFFF7B8U)
+// Factory VREFINT and temperature sensor readings at VDDA = ADC_CAL_MV, 30C
+
+#define ADC_CAL_MV 3300U
+
+#define ADC_STREAM_SAMPLE_CYCLES 54U
+// SYSCLK cycles a stream conversion samples for (13.5 ADC clocks)
+
+#define ADC_MONITOR_PERIOD_CYCLES 104U
+// SYSCLK cycles between monitor conversions (13.5 sample + 12.5 conversion
+// ADC clocks)
+
+#define ADC_BACKGROUND_PERIOD_CYCLES 1008U
+// SYSCLK cycles between background conversions (239.5 sample + 12.5
+// conversion ADC clocks)
+
+#define ADC_START() (ADC1->CR |= ADC_CR_ADSTART)
+// Starts the next conversion of a stream (see AdcStreamStart)
+
+#define ADC_TO_MV(raw, vdda_mv) ((uint16_t)(((uint32_t)(raw) * (vdda_mv)) / ADC_FULL_SCALE))
+// Converts a reading to millivolts given VDDA
+
+/******************************************************************************
+* AdcInit - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables, calibrates and powers up the ADC, clocked by PCLK/4
+* 				(12MHz), with VREFINT and the temperature sensor enabled.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void AdcInit(void);
+
+/******************************************************************************
+* AdcScan - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a set of channels as one scan sequence, results
+* 				written to RAM by DMA1 channel 1, and waits for it to end.
+*
+* Arguments:    uint32_t channels - Channels to convert (bit n = channel n)
+*
+* 				uint16_t *results - One result per channel, lowest channel
+* 				first
+*
+* Return:		Number of results
+******************************************************************************/
+uint8_t AdcScan(uint32_t, uint16_t*);
+
+/******************************************************************************
+* AdcVddaMv - Public Function
+*
+* 08/21/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Computes VDDA from a VREFINT reading and its factory
+* 				calibration.
+*
+* Arguments:    uint16_t vrefint - VREFINT reading
+*
+* Return:		VDDA in millivolts
+******************************************************************************/
+uint16_t AdcVddaMv(uint16_t);
+
+/******************************************************************************
+* AdcStreamStart - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Sets up a stream of single conversions of one channel,
+* 				each started by ADC_START() and written to the next result
+* 				by DMA1 channel 1, so the CPU never waits on a conversion.
+* 				Uses a short sample time (ADC_STREAM_SAMPLE_CYCLES), the
+* 				channel must be driven from a low impedance.
+*
+* Arguments:    uint8_t channel - Channel to convert
+*
+* 				uint16_t *results - Buffer for count results
+*
+* 				uint16_t count - Most conversions in the stream
+*
+* Return:		None
+******************************************************************************/
+void AdcStreamStart(uint8_t, uint16_t*, uint16_t);
+
+/******************************************************************************
+* AdcStreamStop - Public Function
+*
+* 08/23/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits for the last conversion of a stream and restores the
+* 				scan sample time.
+*
+* Arguments:    None
+*
+* Return:		Number of results written
+******************************************************************************/
+uint16_t AdcStreamStop(void);
+
+/******************************************************************************
+* AdcWatchdogSet - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Guards one channel with the analog watchdog. Any conversion
+* 				of the channel above the threshold, by a scan, stream or
+* 				the monitor, raises the ADC interrupt while it is enabled.
+* 				Stops the monitor, restart it afterwards if needed.
+*
+* Arguments:    uint8_t channel - Channel guarded
+*
+* 				uint16_t high - Highest reading allowed
+*
+* Return:		None
+******************************************************************************/
+void AdcWatchdogSet(uint8_t, uint16_t);
+
+/******************************************************************************
+* AdcMonitorStart - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts one channel continuously in hardware, without DMA
+* 				and keeping only the latest result, so the analog watchdog
+* 				checks it every ADC_MONITOR_PERIOD_CYCLES. Scans and
+* 				streams stop the monitor.
+*
+* Arguments:    uint8_t channel - Channel monitored
+*
+* Return:		None
+******************************************************************************/
+void AdcMonitorStart(uint8_t);
+
+/******************************************************************************
+* AdcMonitorStop - Public Function
+*
+* 08/24/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* 08/28/2019:	Anthony Needles
+* 				Also stops background conversion.
+*
+* Description:  Stops continuous monitoring or background conversion, if
+* 				running, and restores scan settings.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void AdcMonitorStop(void);
+
+/******************************************************************************
+* AdcBackgroundStart - Public Function
+*
+* 08/28/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Converts a set of channels continuously as repeated scan
+* 				sequences while the ADC is otherwise unused, with DMA1
+* 				channel 1 writing the results round a circular buffer.
+* 				The DMA half and full transfer interrupts are enabled, the
+* 				user handles DMA1_Channel1_IRQHandler. Uses the longest
+* 				sample time, for the internal channels. Does nothing if
+* 				already running, scans, streams and the monitor stop it.
+*
+* Arguments:    uint32_t channels - Channels to convert (bit n = channel n)
+*
+* 				uint16_t *results - Circular buffer, a whole number of
+* 				sequences in each half
+*
+* 				uint16_t count - Buffer length in results
+*
+* Return:		None
+******************************************************************************/
+void AdcBackgroundStart(uint32_t, uint16_t*, uint16_t);
+
+#endif /* ADC_H_ */
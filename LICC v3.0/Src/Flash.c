@@ -0,0 +1,153 @@
+/******************************************************************************
+* 	Flash.c
+*
+* 	This source file handles erasing and programming the reserved non-volatile
+* 	pages at the end of flash, used to keep calibration and test data across
+* 	resets. The flash interface is unlocked only for the duration of each
+* 	operation.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/06/2019:
+* 	Created page erase and halfword programming for reserved NVM pages.
+*
+* 	Created on: 08/06/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Flash.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define FLASH_NVM_END (FLASH_BANK1_END + 1U)
+
+#define FLASH_IN_NVM(addr, len) (((addr) >= FLASH_NVM_START) && (((addr) + (len)) <= FLASH_NVM_END))
+
+/******************************************************************************
+* Private Function Prototypes
+******************************************************************************/
+static void flashUnlock(void);
+static uint8_t flashWaitDone(void);
+
+/******************************************************************************
+* FlashErasePage - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Erases a single flash page (all bytes read 0xFF). Only
+* 				addresses within the reserved NVM region are accepted.
+* 				Blocks until the erase completes (up to ~40ms).
+*
+* Arguments:    uint32_t page_addr - Start address of page
+*
+* Return:		FLASH_OK or FLASH_ERROR
+******************************************************************************/
+uint8_t FlashErasePage(uint32_t page_addr)
+{
+	uint8_t ret_val;
+
+	if(!FLASH_IN_NVM(page_addr, FLASH_PAGE_SIZE) || (page_addr % FLASH_PAGE_SIZE)) return FLASH_ERROR;
+
+	flashUnlock();
+
+	FLASH->CR |= FLASH_CR_PER;
+	FLASH->AR = page_addr;
+	FLASH->CR |= FLASH_CR_STRT;
+	ret_val = flashWaitDone();
+	FLASH->CR &= ~FLASH_CR_PER;
+
+	FLASH->CR |= FLASH_CR_LOCK;
+	return ret_val;
+}
+
+/******************************************************************************
+* FlashProgram - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Programs an array of halfwords into erased flash, verifying
+* 				each halfword after it is written. Only addresses within the
+* 				reserved NVM region are accepted.
+*
+* Arguments:    uint32_t addr - Destination address (halfword aligned)
+*
+* 				const uint16_t *data - Halfwords to program
+*
+* 				uint16_t num_halfwords - Number of halfwords to program
+*
+* Return:		FLASH_OK or FLASH_ERROR
+******************************************************************************/
+uint8_t FlashProgram(uint32_t addr, const uint16_t *data, uint16_t num_halfwords)
+{
+	volatile uint16_t *dest = (volatile uint16_t *)addr;
+	uint8_t ret_val = FLASH_OK;
+
+	if(!FLASH_IN_NVM(addr, 2U * num_halfwords) || (addr & 0x1U)) return FLASH_ERROR;
+
+	flashUnlock();
+
+	FLASH->CR |= FLASH_CR_PG;
+	for(uint16_t index = 0; index < num_halfwords; index++){
+		dest[index] = data[index];
+		ret_val = flashWaitDone();
+		if((ret_val != FLASH_OK) || (dest[index] != data[index])){
+			ret_val = FLASH_ERROR;
+			break;
+		}
+	}
+	FLASH->CR &= ~FLASH_CR_PG;
+
+	FLASH->CR |= FLASH_CR_LOCK;
+	return ret_val;
+}
+
+/******************************************************************************
+* flashUnlock - Private Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Writes the key sequence to FLASH_KEYR if the flash control
+* 				register is locked.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+static void flashUnlock(void)
+{
+	while(FLASH->SR & FLASH_SR_BSY){}
+
+	if(FLASH->CR & FLASH_CR_LOCK){
+		FLASH->KEYR = FLASH_KEY1;
+		FLASH->KEYR = FLASH_KEY2;
+	}
+}
+
+/******************************************************************************
+* flashWaitDone - Private Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits for the current flash operation to finish, then
+* 				checks and clears the end of operation and error flags.
+*
+* Arguments:    None
+*
+* Return:		FLASH_OK or FLASH_ERROR
+******************************************************************************/
+static uint8_t flashWaitDone(void)
+{
+	uint32_t status;
+
+	while(FLASH->SR & FLASH_SR_BSY){}
+
+	status = FLASH->SR;
+	FLASH->SR = (FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR);
+
+	return (status & (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)) ? FLASH_ERROR : FLASH_OK;
+}
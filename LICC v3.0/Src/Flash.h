@@ -0,0 +1,81 @@
+/******************************************************************************
+* 	Flash.h
+*
+* 	Header for Flash.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/06/2019:
+* 	Created page erase and halfword programming for reserved NVM pages.
+*
+* 	08/09/2019:
+* 	Reserved page for fault log.
+*
+* 	08/17/2019:
+* 	Reserved page for uploaded IC definitions.
+*
+* 	Created on: 08/06/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef FLASH_H_
+#define FLASH_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define FLASH_PAGE_SIZE 0x400U
+// STM32F030x8 flash pages are 1KB
+
+#define FLASH_NVM_START 0x0800F000U
+// Last four pages of flash are reserved for non-volatile data (see NVM region
+// in STM32F030C8Tx_FLASH.ld). Program code shall not be placed here.
+
+#define FLASH_CAL_PAGE (FLASH_NVM_START + (3U * FLASH_PAGE_SIZE))
+// Fixture calibration (SelfTest.c)
+
+#define FLASH_FAILLOG_PAGE (FLASH_NVM_START + (2U * FLASH_PAGE_SIZE))
+// Diagnosed fault log (FailLog.c)
+
+#define FLASH_USERIC_PAGE (FLASH_NVM_START + (1U * FLASH_PAGE_SIZE))
+// Uploaded IC definitions (UserIc.c)
+
+#define FLASH_OK 0U
+#define FLASH_ERROR 1U
+
+/******************************************************************************
+* FlashErasePage - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Erases a single flash page (all bytes read 0xFF). Only
+* 				addresses within the reserved NVM region are accepted.
+* 				Blocks until the erase completes (up to ~40ms).
+*
+* Arguments:    uint32_t page_addr - Start address of page
+*
+* Return:		FLASH_OK or FLASH_ERROR
+******************************************************************************/
+uint8_t FlashErasePage(uint32_t);
+
+/******************************************************************************
+* FlashProgram - Public Function
+*
+* 08/06/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Programs an array of halfwords into erased flash, verifying
+* 				each halfword after it is written. Only addresses within the
+* 				reserved NVM region are accepted.
+*
+* Arguments:    uint32_t addr - Destination address (halfword aligned)
+*
+* 				const uint16_t *data - Halfwords to program
+*
+* 				uint16_t num_halfwords - Number of halfwords to program
+*
+* Return:		FLASH_OK or FLASH_ERROR
+******************************************************************************/
+uint8_t FlashProgram(uint32_t, const uint16_t*, uint16_t);
+
+#endif /* FLASH_H_ */
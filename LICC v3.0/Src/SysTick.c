@@ -13,6 +13,9 @@
 * 	08/03/2019:
 * 	Edited for LICC v3.0 use.
 *
+* 	08/06/2019:
+* 	Added millisecond count getter.
+*
 * 	Created on: 12/08/2018
 * 	Author: Anthony Needles
 ******************************************************************************/
@@ -88,6 +91,24 @@ void SysTickWaitTask(const uint32_t ts_period)
     }
 }
 
+/******************************************************************************
+* SysTickGetMS - Public Function
+*
+* 08/06/2019:   Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the number of milliseconds counted since SysTick
+* 				was initialized.
+*
+* Arguments:    None
+*
+* Return: 		Millisecond count
+******************************************************************************/
+uint32_t SysTickGetMS(void)
+{
+	return systickCurrentMSCount;
+}
+
 /******************************************************************************
 * SysTickHandler - Interrupt Handler
 *
@@ -8,6 +8,9 @@
 * 	12/08/2018:
 * 	Added initialization and handler increments.
 *
+* 	08/06/2019:
+* 	Added millisecond count getter.
+*
 * 	Created on: 12/08/2018
 * 	Author: Anthony Needles
 ******************************************************************************/
@@ -52,6 +55,21 @@ void SysTickInit(void);
 ******************************************************************************/
 //void SysTickWaitTask(const uint32_t);
 
+/******************************************************************************
+* SysTickGetMS - Public Function
+*
+* 08/06/2019:   Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Returns the number of milliseconds counted since SysTick
+* 				was initialized.
+*
+* Arguments:    None
+*
+* Return: 		Millisecond count
+******************************************************************************/
+uint32_t SysTickGetMS(void);
+
 /******************************************************************************
 * SysTickHandler - Interrupt Handler
 *
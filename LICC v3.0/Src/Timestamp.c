@@ -0,0 +1,42 @@
+/******************************************************************************
+* 	Timestamp.c
+*
+* 	Provides a free-running cycle counter on TIM6 for measuring short
+* 	intervals (settle windows, rise times, sample windows). Dependent on 48MHz
+* 	APB1 timer clock derived from 48MHz system clock via HSE and PLL.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/05/2019:
+* 	Created TIM6 free-running cycle counter for short interval measurements.
+*
+* 	Created on: 08/05/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "Timestamp.h"
+
+/******************************************************************************
+* TimestampInit - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables TIM6 as a free-running 16-bit up counter clocked at
+* 				SYSCLK. No interrupts are used, the counter is only read.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void TimestampInit(void)
+{
+	RCC->APB1ENR |= RCC_APB1ENR_TIM6EN;
+
+	TIM6->PSC = 0U;
+	TIM6->ARR = 0xFFFFU;
+
+	// Load prescaler, then start counting
+	TIM6->EGR = TIM_EGR_UG;
+	TIM6->CR1 |= TIM_CR1_CEN;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+* 	Timestamp.h
+*
+* 	Header for Timestamp.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/05/2019:
+* 	Created TIM6 free-running cycle counter for short interval measurements.
+*
+* 	Created on: 08/05/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef TIMESTAMP_H_
+#define TIMESTAMP_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define TIMESTAMP_CLK_HZ 48000000U
+// TIM6 counts SYSCLK cycles (48MHz, no prescaler)
+
+#define TIMESTAMP_NOW() ((uint16_t)TIM6->CNT)
+// Current 16-bit cycle count. Intervals are found by unsigned 16-bit
+// subtraction, so any interval shorter than 65535 cycles (~1.36ms) is valid
+// regardless of counter wrap.
+
+/******************************************************************************
+* TimestampInit - Public Function
+*
+* 08/05/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables TIM6 as a free-running 16-bit up counter clocked at
+* 				SYSCLK. No interrupts are used, the counter is only read.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void TimestampInit(void);
+
+#endif /* TIMESTAMP_H_ */
@@ -0,0 +1,251 @@
+/******************************************************************************
+* 	Usart1.c
+*
+* 	This source file handles the USART1 host link. Transmits and receives
+* 	are made by DMA so the CPU is free while data moves. Dependent on 48MHz PCLK
+* 	derived from 48MHz system clock via HSE and PLL.
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/14/2019:
+* 	Created USART1 DMA transmit.
+*
+* 	08/15/2019:
+* 	Added DMA receive, blocking and circular.
+*
+* 	Created on: 08/14/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#include "stm32f030x8.h"
+#include "SysTick.h"
+#include "Usart1.h"
+
+/******************************************************************************
+* Private Definitions
+******************************************************************************/
+#define USART1_PCLK_HZ 48000000U
+
+#define USART1_TX_PIN 9U
+#define USART1_RX_PIN 10U
+#define USART1_AF 1U
+// PA9/PA10 alternate function 1
+
+/******************************************************************************
+* Private Global Variables
+******************************************************************************/
+static uint16_t usart1RxLen;
+
+/******************************************************************************
+* Usart1Init - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables USART1 on PA9 (TX) and PA10 (RX) at USART1_BAUD.
+* 				USART1 DMA requests are remapped to DMA1 channels 4 (TX)
+* 				and 5 (RX), leaving channels 2 and 3 free for TIM1 paced
+* 				socket transfers.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void Usart1Init(void)
+{
+	RCC->AHBENR |= RCC_AHBENR_GPIOAEN | RCC_AHBENR_DMAEN;
+	RCC->APB2ENR |= RCC_APB2ENR_USART1EN | RCC_APB2ENR_SYSCFGCOMPEN;
+
+	SYSCFG->CFGR1 |= SYSCFG_CFGR1_USART1TX_DMA_RMP | SYSCFG_CFGR1_USART1RX_DMA_RMP;
+
+	GPIOA->AFR[1] = (GPIOA->AFR[1] & ~((0xFU << ((USART1_TX_PIN - 8U) * 4U)) | (0xFU << ((USART1_RX_PIN - 8U) * 4U))))
+					| (USART1_AF << ((USART1_TX_PIN - 8U) * 4U)) | (USART1_AF << ((USART1_RX_PIN - 8U) * 4U));
+	GPIOA->MODER = (GPIOA->MODER & ~((3U << (USART1_TX_PIN * 2U)) | (3U << (USART1_RX_PIN * 2U))))
+				   | (2U << (USART1_TX_PIN * 2U)) | (2U << (USART1_RX_PIN * 2U));
+
+	USART1->CR1 = 0U;
+	USART1->BRR = (USART1_PCLK_HZ + (USART1_BAUD / 2U)) / USART1_BAUD;
+	USART1->CR1 = USART_CR1_TE | USART_CR1_RE | USART_CR1_UE;
+}
+
+/******************************************************************************
+* Usart1Write - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts a DMA transmit of a buffer, first waiting for any
+* 				previous transmit to finish. The buffer must not change
+* 				until Usart1TxDone returns 1.
+*
+* Arguments:    const void *data - Bytes to send
+*
+* 				uint16_t len - Number of bytes
+*
+* Return:		None
+******************************************************************************/
+void Usart1Write(const void *data, uint16_t len)
+{
+	while(Usart1TxDone() == 0U){}
+	if(len == 0U) return;
+
+	DMA1_Channel4->CCR = 0U;
+	DMA1_Channel4->CPAR = (uint32_t)&USART1->TDR;
+	DMA1_Channel4->CMAR = (uint32_t)data;
+	DMA1_Channel4->CNDTR = len;
+	DMA1->IFCR = DMA_IFCR_CGIF4;
+	DMA1_Channel4->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_EN;
+
+	USART1->CR3 |= USART_CR3_DMAT;
+}
+
+/******************************************************************************
+* Usart1TxDone - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Checks whether the last DMA transmit has been handed to the
+* 				USART. Once it has the TX DMA request is released, so DMA1
+* 				channel 4 may be used by TIM1.
+*
+* Arguments:    None
+*
+* Return:		1 if done, 0 if still sending
+******************************************************************************/
+uint8_t Usart1TxDone(void)
+{
+	if((USART1->CR3 & USART_CR3_DMAT) == 0U) return 1U;
+	if((DMA1->ISR & DMA_ISR_TCIF4) == 0U) return 0U;
+
+	USART1->CR3 &= ~USART_CR3_DMAT;
+	DMA1_Channel4->CCR = 0U;
+	DMA1->IFCR = DMA_IFCR_CGIF4;
+	return 1U;
+}
+
+/******************************************************************************
+* Usart1Flush - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits until the last transmit has completely left the
+* 				shift register.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void Usart1Flush(void)
+{
+	while(Usart1TxDone() == 0U){}
+	while((USART1->ISR & USART_ISR_TC) == 0U){}
+}
+
+/******************************************************************************
+* Usart1Read - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Receives a block of bytes by DMA, waiting until it is
+* 				complete or the timeout expires.
+*
+* Arguments:    void *data - Destination
+*
+* 				uint16_t len - Number of bytes
+*
+* 				uint32_t timeout_ms - Longest wait
+*
+* Return:		Number of bytes received
+******************************************************************************/
+uint16_t Usart1Read(void *data, uint16_t len, uint32_t timeout_ms)
+{
+	uint32_t start_ms = SysTickGetMS();
+	uint16_t received;
+
+	if(len == 0U) return 0U;
+
+	Usart1RxStart(data, len, 0U);
+	while((Usart1RxPos() < len) && ((SysTickGetMS() - start_ms) < timeout_ms)){}
+	received = Usart1RxPos();
+	Usart1RxStop();
+	return received;
+}
+
+/******************************************************************************
+* Usart1RxStart - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts DMA reception into a buffer. In circular mode DMA
+* 				wraps to the start of the buffer when it is full and keeps
+* 				receiving until Usart1RxStop. Any byte already waiting in
+* 				the USART is discarded.
+*
+* Arguments:    void *buffer - Receive buffer
+*
+* 				uint16_t len - Buffer length in bytes
+*
+* 				uint8_t circular - 1 for a ring, 0 for a single block
+*
+* Return:		None
+******************************************************************************/
+void Usart1RxStart(void *buffer, uint16_t len, uint8_t circular)
+{
+	USART1->CR3 &= ~USART_CR3_DMAR;
+	USART1->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NCF;
+	(void)USART1->RDR;
+
+	DMA1_Channel5->CCR = 0U;
+	DMA1_Channel5->CPAR = (uint32_t)&USART1->RDR;
+	DMA1_Channel5->CMAR = (uint32_t)buffer;
+	DMA1_Channel5->CNDTR = len;
+	DMA1->IFCR = DMA_IFCR_CGIF5;
+	usart1RxLen = len;
+	DMA1_Channel5->CCR = DMA_CCR_MINC | ((circular != 0U) ? DMA_CCR_CIRC : 0U) | DMA_CCR_EN;
+
+	USART1->CR3 |= USART_CR3_DMAR;
+}
+
+/******************************************************************************
+* Usart1RxPos - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives the offset in the receive buffer that the next byte
+* 				will be written to (the number of bytes received for a
+* 				single block).
+*
+* Arguments:    None
+*
+* Return:		Write offset in bytes
+******************************************************************************/
+uint16_t Usart1RxPos(void)
+{
+	uint16_t remaining = DMA1_Channel5->CNDTR;
+
+	// A circular ring reloads CNDTR the moment it wraps
+	return (remaining == usart1RxLen) ? 0U : (uint16_t)(usart1RxLen - remaining);
+}
+
+/******************************************************************************
+* Usart1RxStop - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Stops DMA reception and releases DMA1 channel 5.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void Usart1RxStop(void)
+{
+	USART1->CR3 &= ~USART_CR3_DMAR;
+	DMA1_Channel5->CCR = 0U;
+	DMA1->IFCR = DMA_IFCR_CGIF5;
+}
@@ -0,0 +1,161 @@
+/******************************************************************************
+* 	Usart1.h
+*
+* 	Header for Usart1.c
+*
+* 	MCU: STM32F030C8Tx
+*
+* 	08/14/2019:
+* 	Created USART1 DMA transmit.
+*
+* 	08/15/2019:
+* 	Added DMA receive, blocking and circular.
+*
+* 	Created on: 08/14/2019
+* 	Author: Anthony Needles
+******************************************************************************/
+#ifndef USART1_H_
+#define USART1_H_
+
+/******************************************************************************
+* Public Definitions
+******************************************************************************/
+#define USART1_BAUD 921600U
+// Host link baud rate, 8N1
+
+/******************************************************************************
+* Usart1Init - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Enables USART1 on PA9 (TX) and PA10 (RX) at USART1_BAUD.
+* 				USART1 DMA requests are remapped to DMA1 channels 4 (TX)
+* 				and 5 (RX), leaving channels 2 and 3 free for TIM1 paced
+* 				socket transfers.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void Usart1Init(void);
+
+/******************************************************************************
+* Usart1Write - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts a DMA transmit of a buffer, first waiting for any
+* 				previous transmit to finish. The buffer must not change
+* 				until Usart1TxDone returns 1.
+*
+* Arguments:    const void *data - Bytes to send
+*
+* 				uint16_t len - Number of bytes
+*
+* Return:		None
+******************************************************************************/
+void Usart1Write(const void*, uint16_t);
+
+/******************************************************************************
+* Usart1TxDone - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Checks whether the last DMA transmit has been handed to the
+* 				USART. Once it has the TX DMA request is released, so DMA1
+* 				channel 4 may be used by TIM1.
+*
+* Arguments:    None
+*
+* Return:		1 if done, 0 if still sending
+******************************************************************************/
+uint8_t Usart1TxDone(void);
+
+/******************************************************************************
+* Usart1Flush - Public Function
+*
+* 08/14/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Waits until the last transmit has completely left the
+* 				shift register.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void Usart1Flush(void);
+
+/******************************************************************************
+* Usart1Read - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Receives a block of bytes by DMA, waiting until it is
+* 				complete or the timeout expires.
+*
+* Arguments:    void *data - Destination
+*
+* 				uint16_t len - Number of bytes
+*
+* 				uint32_t timeout_ms - Longest wait
+*
+* Return:		Number of bytes received
+******************************************************************************/
+uint16_t Usart1Read(void*, uint16_t, uint32_t);
+
+/******************************************************************************
+* Usart1RxStart - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Starts DMA reception into a buffer. In circular mode DMA
+* 				wraps to the start of the buffer when it is full and keeps
+* 				receiving until Usart1RxStop.
+*
+* Arguments:    void *buffer - Receive buffer
+*
+* 				uint16_t len - Buffer length in bytes
+*
+* 				uint8_t circular - 1 for a ring, 0 for a single block
+*
+* Return:		None
+******************************************************************************/
+void Usart1RxStart(void*, uint16_t, uint8_t);
+
+/******************************************************************************
+* Usart1RxPos - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Gives the offset in the receive buffer that the next byte
+* 				will be written to (the number of bytes received for a
+* 				single block).
+*
+* Arguments:    None
+*
+* Return:		Write offset in bytes
+******************************************************************************/
+uint16_t Usart1RxPos(void);
+
+/******************************************************************************
+* Usart1RxStop - Public Function
+*
+* 08/15/2019:	Anthony Needles
+* 				Started and completed function.
+*
+* Description:  Stops DMA reception and releases DMA1 channel 5.
+*
+* Arguments:    None
+*
+* Return:		None
+******************************************************************************/
+void Usart1RxStop(void);
+
+#endif /* USART1_H_ */
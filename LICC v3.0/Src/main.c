@@ -9,13 +9,47 @@
 *	08/02/2019:
 *	LICC v3.1.0 - Added Clock Config and SysTick config
 *
+*	08/05/2019:
+*	LICC v3.2.0 - Added Timestamp and Checker initialization
+*
+*	08/06/2019:
+*	LICC v3.3.0 - Added power-up fixture self-test
+*
+*	08/11/2019:
+*	LICC v3.4.0 - Added 74HC164 shift register
+*
+*	08/12/2019:
+*	LICC v3.5.0 - Added 74HC393 counter
+*
+*	08/14/2019:
+*	LICC v3.6.0 - Added USART1 host link and logic analyzer
+*
+*	08/16/2019:
+*	LICC v3.7.0 - Added host pin control commands
+*
+*	08/17/2019:
+*	LICC v3.8.0 - Added runtime upload of IC definitions
+*
+*	08/21/2019:
+*	LICC v3.9.0 - Added ADC and parametric output level measurement
+*
+*	08/28/2019:
+*	LICC v3.10.0 - Added die temperature and VDDA test condition logging
+*
 * 	Created on: 08/02/2019
 * 	Author: Anthony Needles
 ******************************************************************************/
 #include "stm32f030x8.h"
 #include "ClockConfig.h"
 #include "SysTick.h"
+#include "Timestamp.h"
+#include "Socket.h"
+#include "Usart1.h"
+#include "Adc.h"
 #include "Checker.h"
+#include "Conditions.h"
+#include "SelfTest.h"
+#include "Command.h"
 
 /******************************************************************************
 * Public Definitions
@@ -29,19 +63,30 @@
 #define MASK_74HC20 0x00000020
 #define MASK_74HC27 0x00000040
 #define MASK_74HC86 0x00000080
+#define MASK_74HC164 0x00000100
+#define MASK_74HC393 0x00000200
 // Bit field mask for setting a single bit for a specific test pass, one per IC
 
 typedef enum{IDLE, CHECK_74HC00, CHECK_74HC02, CHECK_74HC04, CHECK_74HC08,
 			 CHECK_74HC10, CHECK_74HC20, CHECK_74HC27, CHECK_74HC86,
-			 DISPLAY_RESULT
+			 CHECK_74HC164, CHECK_74HC393, DISPLAY_RESULT
 } CONTROL_STATE_T;
 
 int main(void)
 {
 	ClkCfgInit();
 	SysTickInit();
+	TimestampInit();
+	Usart1Init();
+	AdcInit();
+	CheckerInit();
+	CondInit();
+	SelfTestRun();
+	CommandInit();
 
 	while (1){
+		CondService();
+		CommandPoll();
 //		SysTickWaitTask();
 	}
 }